@@ -18,7 +18,9 @@
 #
 
 
-def evolve_genomes(rng, pop, params, recorder=None):
+def evolve_genomes(rng, pop, params, recorder=None,
+                   gamete_compaction_threshold=0.0, nthreads=None,
+                   background_selection=None):
     """
     Evolve a population without tree sequence recordings.  In other words,
     complete genomes must be simulated and tracked.
@@ -31,13 +33,39 @@ def evolve_genomes(rng, pop, params, recorder=None):
     :type params: :class:`fwdpy11.ModelParams`
     :param recorder: (None) A temporal sampler/data recorder.
     :type recorder: callable
+    :param gamete_compaction_threshold: (0.0) Compact the gamete container when the fraction of extant gametes falls below this value.
+    :type gamete_compaction_threshold: float
+    :param nthreads: (None) Number of threads used to calculate fitness.
+    :type nthreads: int
+    :param background_selection: (None) Fitness-class model of weakly deleterious mutations.
+    :type background_selection: :class:`fwdpy11.BackgroundSelection`
 
     .. note::
         If recorder is None,
         then :class:`fwdpy11.RecordNothing` will be used.
 
+    When the fraction of elements of :attr:`fwdpy11.DiploidPopulation.haploid_genomes`
+    with a nonzero count falls below `gamete_compaction_threshold`, the extinct
+    genomes are removed, the indexes stored in :attr:`fwdpy11.DiploidPopulation.diploids`
+    are updated accordingly, and unused memory is released.  The default value of
+    0.0 disables compaction.  Compaction does not affect the outcome of a simulation,
+    but gamete indexes will differ from those of an uncompacted run.
+
+    If `nthreads` is not None, genetic values, noise, and fitnesses are calculated
+    by `nthreads` threads for the built-in genetic value types, unless
+    `cache_haploid_effects` is set.  The mapping of genetic values to fitness
+    and the noise must be built-in types, too, as other types are not known
+    to be safe to call from several threads.  Otherwise, the evaluation is
+    serial.  The random noise is then taken from streams
+    derived from `rng` once per generation, so that the results are the same for
+    any number of threads.  They will differ from those obtained when `nthreads` is None.
+
     """
     import warnings
+    if nthreads is None:
+        nthreads = 0
+    elif nthreads < 1:
+        raise ValueError("nthreads must be None or a positive integer")
     # Test parameters while suppressing warnings
     with warnings.catch_warnings():
         warnings.simplefilter("ignore")
@@ -58,4 +86,6 @@ def evolve_genomes(rng, pop, params, recorder=None):
     evolve_without_tree_sequences(rng, pop, params.demography,
                                   params.mutrate_n, params.mutrate_s,
                                   params.recrate, mm, rm, params.gvalue,
-                                  recorder, params.pself, params.prune_selected)
+                                  recorder, params.pself, params.prune_selected,
+                                  gamete_compaction_threshold, nthreads,
+                                  background_selection)
@@ -18,11 +18,61 @@
 #
 
 
+def _evolvets_setup(params, recorder, stopping_criterion, nthreads):
+    """
+    Validate params and return the arguments shared by
+    all calls to evolve_with_tree_sequences.
+    """
+    import warnings
+
+    # Currently, we do not support simulating neutral mutations
+    # during tree sequence simulations, so we make sure that there
+    # are no neutral regions/rates:
+    if len(params.nregions) != 0:
+        raise ValueError(
+            "Simulation of neutral mutations on tree sequences not supported (yet).")
+
+    # Test parameters while suppressing warnings
+    with warnings.catch_warnings():
+        warnings.simplefilter("ignore")
+        # Will throw exception if anything is wrong:
+        params.validate()
+
+    if recorder is None:
+        from ._fwdpy11 import NoAncientSamples
+        recorder = NoAncientSamples()
+
+    if stopping_criterion is None:
+        from ._fwdpy11 import _no_stopping
+        stopping_criterion = _no_stopping
+
+    from ._fwdpy11 import MutationRegions
+    from ._fwdpy11 import dispatch_create_GeneticMap
+    from ._fwdpy11 import FiniteSites
+    # Each mutation must be a distinct site in the tables
+    if any(isinstance(i, FiniteSites) and i.recurrent
+           for i in params.sregions):
+        raise ValueError(
+            "recurrent mutation is not supported with tree sequences")
+    # TODO: update to allow neutral mutations
+    pneutral = 0
+    mm = MutationRegions.create(pneutral, params.nregions, params.sregions)
+    rm = dispatch_create_GeneticMap(params.recrate, params.recregions)
+
+    if nthreads is None:
+        nthreads = 0
+    elif nthreads < 1:
+        raise ValueError("nthreads must be None or a positive integer")
+
+    return recorder, stopping_criterion, mm, rm, nthreads
+
+
 def evolvets(rng, pop, params, simplification_interval, recorder=None,
            suppress_table_indexing=False, record_gvalue_matrix=False,
            stopping_criterion=None,
            track_mutation_counts=False,
-           remove_extinct_variants=True):
+           remove_extinct_variants=True,
+           gamete_compaction_threshold=0.0, nthreads=None):
     """
     Evolve a population with tree sequence recording
 
@@ -40,6 +90,10 @@ def evolvets(rng, pop, params, simplification_interval, recorder=None,
     :type suppress_table_indexing: boolean
     :param record_gvalue_matrix: (False) Whether to record genetic values into :attr:`fwdpy11.Population.genetic_values`.
     :type record_gvalue_matrix: boolean
+    :param gamete_compaction_threshold: (0.0) Compact the gamete container when the fraction of extant gametes falls below this value.
+    :type gamete_compaction_threshold: float
+    :param nthreads: (None) Number of threads used to calculate fitness.
+    :type nthreads: int
 
     The recording of genetic values into :attr:`fwdpy11.Population.genetic_values` is supprssed by default.  First, it
     is redundant with :attr:`fwdpy11.DiploidMetadata.g` for the common case of mutational effects on a single trait.
@@ -50,37 +104,20 @@ def evolvets(rng, pop, params, simplification_interval, recorder=None,
         If recorder is None,
         then :class:`fwdpy11.NoAncientSamples` will be used.
 
-    """
-    import warnings
+    If `nthreads` is not None, genetic values, noise, and fitnesses are calculated
+    by `nthreads` threads for the built-in genetic value types, unless
+    `cache_haploid_effects` is set.  The mapping of genetic values to fitness
+    and the noise must be built-in types, too, as other types are not known
+    to be safe to call from several threads.  Otherwise, the evaluation is
+    serial.  The random noise is then taken from streams
+    derived from `rng` once per generation, so that the results are the same for
+    any number of threads.  They will differ from those obtained when `nthreads` is None.
 
-    # Currently, we do not support simulating neutral mutations
-    # during tree sequence simulations, so we make sure that there
-    # are no neutral regions/rates:
-    if len(params.nregions) != 0:
-        raise ValueError(
-            "Simulation of neutral mutations on tree sequences not supported (yet).")
-
-    # Test parameters while suppressing warnings
-    with warnings.catch_warnings():
-        warnings.simplefilter("ignore")
-        # Will throw exception if anything is wrong:
-        params.validate()
-
-    if recorder is None:
-        from ._fwdpy11 import NoAncientSamples
-        recorder = NoAncientSamples()
-
-    if stopping_criterion is None:
-        from ._fwdpy11 import _no_stopping
-        stopping_criterion = _no_stopping
-
-    from ._fwdpy11 import MutationRegions
-    from ._fwdpy11 import dispatch_create_GeneticMap
+    """
     from ._fwdpy11 import evolve_with_tree_sequences
-    # TODO: update to allow neutral mutations
-    pneutral = 0
-    mm = MutationRegions.create(pneutral, params.nregions, params.sregions)
-    rm = dispatch_create_GeneticMap(params.recrate, params.recregions)
+    from ._fwdpy11 import _TreeSequenceEvolutionState
+    recorder, stopping_criterion, mm, rm, nthreads = _evolvets_setup(
+        params, recorder, stopping_criterion, nthreads)
 
     from ._fwdpy11 import SampleRecorder
     sr = SampleRecorder()
@@ -91,4 +128,72 @@ def evolvets(rng, pop, params, simplification_interval, recorder=None,
                                params.pself, params.prune_selected is False,
                                suppress_table_indexing, record_gvalue_matrix,
                                track_mutation_counts,
-                               remove_extinct_variants)
+                               remove_extinct_variants,
+                               gamete_compaction_threshold, nthreads,
+                               _TreeSequenceEvolutionState(),
+                               len(params.demography), False)
+
+
+def evolve_iter(rng, pop, params, simplification_interval, every,
+                simplify=True, recorder=None,
+                suppress_table_indexing=False, record_gvalue_matrix=False,
+                stopping_criterion=None,
+                track_mutation_counts=False,
+                remove_extinct_variants=True,
+                gamete_compaction_threshold=0.0, nthreads=None):
+    """
+    Evolve a population with tree sequence recording,
+    yielding the population every `every` generations.
+
+    :param every: Number of generations between yields.
+    :type every: int
+    :param simplify: (True) Simplify the tables before each yield.
+    :type simplify: boolean
+
+    The remaining parameters are the same as for :func:`fwdpy11.evolvets`.
+    The internal state of the simulation, such as the recycling bins
+    and the workspace used for simplification, is kept between yields.
+    The population is yielded after the last generation, too, at which
+    point it is in the same state as after a call to :func:`fwdpy11.evolvets`.
+
+    If `simplify` is False, :attr:`fwdpy11.Population.mcounts` is
+    recounted from the gametes of the alive individuals before each yield.
+    :attr:`fwdpy11.Population.mcounts_ancient_samples` is only updated
+    when the tables are simplified, and so may be stale in that case.
+
+    The yielded population must not be modified.
+    If the iteration is abandoned before the end, the tables of the population
+    may not be simplified.
+
+    .. versionadded:: 0.5.0
+
+    """
+    if every < 1:
+        raise ValueError("every must be a positive integer")
+
+    from ._fwdpy11 import evolve_with_tree_sequences
+    from ._fwdpy11 import _TreeSequenceEvolutionState
+    from ._fwdpy11 import SampleRecorder
+    recorder, stopping_criterion, mm, rm, nthreads = _evolvets_setup(
+        params, recorder, stopping_criterion, nthreads)
+
+    state = _TreeSequenceEvolutionState()
+    sr = SampleRecorder()
+    finished = False
+    while not finished:
+        finished = evolve_with_tree_sequences(rng, pop, sr,
+                                              simplification_interval,
+                                              params.demography,
+                                              params.mutrate_s,
+                                              mm, rm, params.gvalue,
+                                              recorder, stopping_criterion,
+                                              params.pself,
+                                              params.prune_selected is False,
+                                              suppress_table_indexing,
+                                              record_gvalue_matrix,
+                                              track_mutation_counts,
+                                              remove_extinct_variants,
+                                              gamete_compaction_threshold,
+                                              nthreads, state, every,
+                                              simplify)
+        yield pop
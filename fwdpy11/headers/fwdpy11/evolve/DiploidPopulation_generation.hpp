@@ -20,28 +20,66 @@
 #define FWDPY11_EVOLVE_POP_GENERATION_HPP__
 
 #include <tuple>
+#include <vector>
+#include <algorithm>
 #include <type_traits>
 #include <stdexcept>
 #include <fwdpp/internal/gamete_cleaner.hpp>
+#include <fwdpp/internal/sample_diploid_helpers.hpp>
 #include <fwdpp/insertion_policies.hpp>
-#include <fwdpp/mutate_recombine.hpp>
+#include <fwdpp/simfunctions/recycling.hpp>
 #include <fwdpy11/rng.hpp>
+#include <fwdpy11/evolve/mutate_recombine.hpp>
+#include <fwdpy11/evolve/background_selection.hpp>
 #include <fwdpy11/types/DiploidPopulation.hpp>
 #include <fwdpy11/genetic_values/DiploidPopulationGeneticValue.hpp>
 #include <gsl/gsl_randist.h>
 
 namespace fwdpy11
 {
+    template <typename mutation_model, typename queue_t, typename mcont_t>
+    inline std::vector<fwdpp::uint_t>
+    generate_new_mutations(const GSLrng_t& rng, const double mu,
+                           queue_t& mutation_recycling_bin,
+                           mcont_t& mutations, const mutation_model& mmodel)
+    /// Returns the keys of a Poisson number of new mutations,
+    /// sorted by position.  No allocation happens if there
+    /// are no new mutations.
+    {
+        std::vector<fwdpp::uint_t> rv;
+        unsigned nmuts = gsl_ran_poisson(rng.get(), mu);
+        if (nmuts == 0)
+            {
+                return rv;
+            }
+        rv.reserve(nmuts);
+        for (unsigned i = 0; i < nmuts; ++i)
+            {
+                rv.push_back(mmodel(mutation_recycling_bin, mutations));
+            }
+        std::sort(begin(rv), end(rv),
+                  [&mutations](const fwdpp::uint_t a, const fwdpp::uint_t b) {
+                      return mutations[a].pos < mutations[b].pos;
+                  });
+        return rv;
+    }
+
     template <typename poptype, typename pick1_function,
               typename pick2_function, typename update_function,
-              typename mutation_model, typename recombination_model>
+              typename mutation_model, typename recombination_model,
+              typename observer_t, typename background_t>
     void
     evolve_generation(const GSLrng_t& rng, poptype& pop,
                       const fwdpp::uint_t N_next, const double mu,
                       const mutation_model& mmodel,
                       const recombination_model& recmodel,
                       const pick1_function& pick1, const pick2_function& pick2,
-                      const update_function& update)
+                      const update_function& update,
+                      observer_t& observer, background_t& background)
+    /// observer is either a haploid_effects_cache or a
+    /// detail::no_gamete_observer.  See mutate_recombine.
+    /// background is either a BackgroundSelection or a
+    /// detail::no_background_selection.
     {
         static_assert(
             std::is_same<typename poptype::popmodel_t,
@@ -61,6 +99,7 @@ namespace fwdpy11
 
         decltype(pop.diploids) offspring(N_next);
         decltype(pop.diploid_metadata) offspring_metadata(N_next);
+        background.begin_generation(N_next);
         // Generate the offspring
         std::size_t label = 0;
         for (auto& dip : offspring)
@@ -74,18 +113,32 @@ namespace fwdpy11
                 auto p2g2 = pop.diploids[p2].second;
 
                 // Mendel
-                if (gsl_rng_uniform(rng.get()) < 0.5)
+                const bool swap1 = gsl_rng_uniform(rng.get()) < 0.5;
+                if (swap1)
                     std::swap(p1g1, p1g2);
-                if (gsl_rng_uniform(rng.get()) < 0.5)
+                const bool swap2 = gsl_rng_uniform(rng.get()) < 0.5;
+                if (swap2)
                     std::swap(p2g1, p2g2);
 
-                // Update to fwdpp 0.5.7 API
-                // in fwdpy11 0.1.4
-                fwdpp::mutate_recombine_update(
-                    rng.get(), pop.gametes, pop.mutations,
-                    std::make_tuple(p1g1, p1g2, p2g1, p2g2), recmodel, mmodel,
-                    mu, gamete_recycling_bin, mutation_recycling_bin, dip,
-                    pop.neutral, pop.selected);
+                auto breakpoints1 = recmodel();
+                auto breakpoints2 = recmodel();
+                auto new_mutations1 = generate_new_mutations(
+                    rng, mu, mutation_recycling_bin, pop.mutations, mmodel);
+                auto new_mutations2 = generate_new_mutations(
+                    rng, mu, mutation_recycling_bin, pop.mutations, mmodel);
+                dip.first = fwdpy11::mutate_recombine(
+                    new_mutations1, breakpoints1, p1g1, p1g2, pop.gametes,
+                    pop.mutations, gamete_recycling_bin, pop.neutral,
+                    pop.selected, observer);
+                dip.second = fwdpy11::mutate_recombine(
+                    new_mutations2, breakpoints2, p2g1, p2g2, pop.gametes,
+                    pop.mutations, gamete_recycling_bin, pop.neutral,
+                    pop.selected, observer);
+                pop.gametes[dip.first].n++;
+                pop.gametes[dip.second].n++;
+                background.inherit(rng, 2 * label, p1, swap1, breakpoints1);
+                background.inherit(rng, 2 * label + 1, p2, swap2,
+                                   breakpoints2);
 
 #ifndef NDEBUG
                 if (pop.gametes[dip.first].n == 0
@@ -100,12 +153,47 @@ namespace fwdpy11
                        pop.diploid_metadata);
             }
 
+        background.end_generation();
         fwdpp::fwdpp_internal::process_gametes(pop.gametes, pop.mutations,
                                                pop.mcounts);
         // This is constant-time
         pop.diploids.swap(offspring);
         pop.diploid_metadata.swap(offspring_metadata);
     }
+
+    template <typename poptype, typename pick1_function,
+              typename pick2_function, typename update_function,
+              typename mutation_model, typename recombination_model,
+              typename observer_t>
+    void
+    evolve_generation(const GSLrng_t& rng, poptype& pop,
+                      const fwdpp::uint_t N_next, const double mu,
+                      const mutation_model& mmodel,
+                      const recombination_model& recmodel,
+                      const pick1_function& pick1, const pick2_function& pick2,
+                      const update_function& update,
+                      observer_t& observer)
+    {
+        detail::no_background_selection no_background;
+        evolve_generation(rng, pop, N_next, mu, mmodel, recmodel, pick1, pick2,
+                          update, observer, no_background);
+    }
+
+    template <typename poptype, typename pick1_function,
+              typename pick2_function, typename update_function,
+              typename mutation_model, typename recombination_model>
+    void
+    evolve_generation(const GSLrng_t& rng, poptype& pop,
+                      const fwdpp::uint_t N_next, const double mu,
+                      const mutation_model& mmodel,
+                      const recombination_model& recmodel,
+                      const pick1_function& pick1, const pick2_function& pick2,
+                      const update_function& update)
+    {
+        detail::no_gamete_observer no_observer;
+        evolve_generation(rng, pop, N_next, mu, mmodel, recmodel, pick1, pick2,
+                          update, no_observer);
+    }
 } // namespace fwdpy11
 
 #endif
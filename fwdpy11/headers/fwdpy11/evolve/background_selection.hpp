@@ -0,0 +1,258 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_EVOLVE_BACKGROUND_SELECTION_HPP__
+#define FWDPY11_EVOLVE_BACKGROUND_SELECTION_HPP__
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <tuple>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <gsl/gsl_randist.h>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/types/Diploid.hpp>
+
+namespace fwdpy11
+{
+    struct BackgroundSelection
+    /// Fitness-class approximation to background selection.
+    ///
+    /// Weakly deleterious mutations in a set of non-overlapping
+    /// blocks are not stored as Mutation objects.  Instead, each
+    /// haploid genome carries the number of such mutations in each
+    /// block.  A block is inherited as a unit from the parental
+    /// genome that is transmitted at the block's midpoint, and
+    /// gains a Poisson number of new mutations.  Each mutation in
+    /// block b multiplies fitness by 1 - s_b.
+    ///
+    /// The counts of haploid genome j of diploid i are
+    /// loads[(2 * i + j) * nblocks()] onwards.  After each
+    /// generation, the minimum count of each block is subtracted,
+    /// which removes fixed mutations without affecting relative
+    /// fitness.
+    ///
+    /// The counts describe one population at one generation,
+    /// recorded by synchronize.  initialize discards them
+    /// when used with any other population or generation.
+    {
+        std::vector<double> beg, end, midpoint, mutation_rate,
+            selection_coefficient, log_fitness;
+        std::vector<std::uint32_t> loads, offspring_loads;
+        /// The serial number and generation of the
+        /// population described by loads.
+        std::uint64_t population;
+        std::uint32_t generation;
+
+        explicit BackgroundSelection(
+            const std::vector<std::tuple<double, double, double, double>>&
+                blocks)
+            : beg{}, end{}, midpoint{}, mutation_rate{},
+              selection_coefficient{}, log_fitness{}, loads{},
+              offspring_loads{}, population(0), generation(0)
+        {
+            if (blocks.empty())
+                {
+                    throw std::invalid_argument("no blocks specified");
+                }
+            for (auto& b : blocks)
+                {
+                    double l, r, u, s;
+                    std::tie(l, r, u, s) = b;
+                    if (!std::isfinite(l) || !std::isfinite(r) || !(l < r))
+                        {
+                            throw std::invalid_argument(
+                                "invalid block boundaries");
+                        }
+                    if (!end.empty() && l < end.back())
+                        {
+                            throw std::invalid_argument(
+                                "blocks must be sorted and non-overlapping");
+                        }
+                    if (!std::isfinite(u) || u < 0.0)
+                        {
+                            throw std::invalid_argument(
+                                "mutation rates must be non-negative");
+                        }
+                    if (!std::isfinite(s) || s < 0.0 || s >= 1.0)
+                        {
+                            throw std::invalid_argument(
+                                "selection coefficients must be in [0, 1)");
+                        }
+                    beg.push_back(l);
+                    end.push_back(r);
+                    midpoint.push_back(l + (r - l) / 2.0);
+                    mutation_rate.push_back(u);
+                    selection_coefficient.push_back(s);
+                    log_fitness.push_back(std::log1p(-s));
+                }
+        }
+
+        inline std::size_t
+        nblocks() const
+        {
+            return beg.size();
+        }
+
+        void
+        reset()
+        {
+            loads.clear();
+            population = 0;
+        }
+
+        template <typename poptype>
+        void
+        initialize(const poptype& pop)
+        /// Called when a simulation starts.  The counts are kept
+        /// if they were last synchronized with pop at its current
+        /// generation and match its size.  Otherwise, they start
+        /// at zero.
+        {
+            if (population != pop.serial.value || generation != pop.generation
+                || loads.size() != 2 * pop.N * nblocks())
+                {
+                    loads.assign(2 * pop.N * nblocks(), 0);
+                }
+            synchronize(pop);
+        }
+
+        template <typename poptype>
+        void
+        synchronize(const poptype& pop)
+        /// Records that the counts describe pop at its
+        /// current generation.
+        {
+            population = pop.serial.value;
+            generation = pop.generation;
+        }
+
+        // The next three functions are called by evolve_generation
+
+        void
+        begin_generation(const std::size_t N_next)
+        {
+            offspring_loads.resize(2 * N_next * nblocks());
+        }
+
+        void
+        inherit(const GSLrng_t& rng, const std::size_t offspring_genome,
+                const std::size_t parent, const bool swapped,
+                const std::vector<double>& breakpoints)
+        /// breakpoints are those passed to mutate_recombine, which
+        /// starts with parental genome 2 * parent + swapped.  As in
+        /// recombine_keys, a midpoint equal to a breakpoint is
+        /// inherited from the genome before the breakpoint.
+        {
+            const auto nb = nblocks();
+            const std::size_t first = 2 * parent + (swapped ? 1 : 0);
+            const std::size_t second = 2 * parent + (swapped ? 0 : 1);
+            auto out = offspring_loads.data() + offspring_genome * nb;
+            std::size_t j = 0;
+            bool from_second = false;
+            for (std::size_t b = 0; b < nb; ++b)
+                {
+                    while (j < breakpoints.size()
+                           && breakpoints[j] < midpoint[b])
+                        {
+                            from_second = !from_second;
+                            ++j;
+                        }
+                    out[b] = loads[(from_second ? second : first) * nb + b];
+                    if (mutation_rate[b] > 0.0)
+                        {
+                            out[b] += gsl_ran_poisson(rng.get(),
+                                                      mutation_rate[b]);
+                        }
+                }
+        }
+
+        void
+        end_generation()
+        {
+            const auto nb = nblocks();
+            const auto ngenomes = offspring_loads.size() / nb;
+            for (std::size_t b = 0; b < nb; ++b)
+                {
+                    auto m = std::numeric_limits<std::uint32_t>::max();
+                    for (std::size_t g = 0; g < ngenomes; ++g)
+                        {
+                            m = std::min(m, offspring_loads[g * nb + b]);
+                        }
+                    for (std::size_t g = 0; g < ngenomes; ++g)
+                        {
+                            offspring_loads[g * nb + b] -= m;
+                        }
+                }
+            loads.swap(offspring_loads);
+        }
+
+        inline double
+        fitness(const std::size_t diploid) const
+        {
+            const auto nb = nblocks();
+            const auto a = loads.data() + 2 * diploid * nb;
+            const auto b = a + nb;
+            double x = 0.0;
+            for (std::size_t i = 0; i < nb; ++i)
+                {
+                    x += log_fitness[i] * static_cast<double>(a[i] + b[i]);
+                }
+            return std::exp(x);
+        }
+
+        void
+        apply(std::vector<DiploidMetadata>& metadata) const
+        /// Multiplies each diploid's fitness by its
+        /// background selection fitness.
+        {
+            for (std::size_t i = 0; i < metadata.size(); ++i)
+                {
+                    metadata[i].w *= fitness(i);
+                }
+        }
+    };
+
+    namespace detail
+    {
+        struct no_background_selection
+        /// Used by evolve_generation when
+        /// BackgroundSelection is not in use.
+        {
+            void
+            begin_generation(std::size_t)
+            {
+            }
+
+            void
+            inherit(const GSLrng_t&, std::size_t, std::size_t, bool,
+                    const std::vector<double>&)
+            {
+            }
+
+            void
+            end_generation()
+            {
+            }
+        };
+    } // namespace detail
+} // namespace fwdpy11
+
+#endif
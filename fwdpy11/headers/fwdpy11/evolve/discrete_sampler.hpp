@@ -0,0 +1,183 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_EVOLVE_DISCRETE_SAMPLER_HPP__
+#define FWDPY11_EVOLVE_DISCRETE_SAMPLER_HPP__
+
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+#include <gsl/gsl_rng.h>
+#include <fwdpy11/rng.hpp>
+
+namespace fwdpy11
+{
+    class discrete_sampler
+    /// Samples indexes 0 to n - 1 with probabilities proportional
+    /// to non-negative weights, using Walker's alias method.
+    ///
+    /// This class replaces gsl_ran_discrete_preproc and gsl_ran_discrete
+    /// in the evolve functions.  The table is built by the same algorithm,
+    /// and sampling consumes one uniform deviate per draw, as in GSL,
+    /// so that results are identical to those obtained with GSL.
+    /// Unlike GSL, all storage is retained by the object, so that
+    /// rebuilding the table for a new set of weights does not allocate
+    /// unless the number of weights grows.
+    {
+      private:
+        // F[k] = (k + P(k is not aliased)) / n, A[k] = alias of k
+        std::vector<double> F, E;
+        std::vector<std::size_t> A, smalls, bigs;
+
+        void
+        build(const double total)
+        {
+            const auto n = E.size();
+            const double mean = 1.0 / static_cast<double>(n);
+            smalls.clear();
+            bigs.clear();
+            F.resize(n);
+            A.resize(n);
+            for (std::size_t k = 0; k < n; ++k)
+                {
+                    E[k] /= total;
+                    if (E[k] < mean)
+                        {
+                            smalls.push_back(k);
+                        }
+                    else
+                        {
+                            bigs.push_back(k);
+                        }
+                }
+            while (!smalls.empty())
+                {
+                    auto s = smalls.back();
+                    smalls.pop_back();
+                    if (bigs.empty())
+                        {
+                            A[s] = s;
+                            F[s] = 1.0;
+                            continue;
+                        }
+                    auto b = bigs.back();
+                    bigs.pop_back();
+                    A[s] = b;
+                    F[s] = static_cast<double>(n) * E[s];
+                    auto d = mean - E[s];
+                    E[s] += d;
+                    E[b] -= d;
+                    if (E[b] < mean)
+                        {
+                            smalls.push_back(b);
+                        }
+                    else if (E[b] > mean)
+                        {
+                            bigs.push_back(b);
+                        }
+                    else
+                        {
+                            A[b] = b;
+                            F[b] = 1.0;
+                        }
+                }
+            while (!bigs.empty())
+                {
+                    auto b = bigs.back();
+                    bigs.pop_back();
+                    A[b] = b;
+                    F[b] = 1.0;
+                }
+            for (std::size_t k = 0; k < n; ++k)
+                {
+                    F[k] += static_cast<double>(k);
+                    F[k] /= static_cast<double>(n);
+                }
+        }
+
+      public:
+        discrete_sampler() : F{}, E{}, A{}, smalls{}, bigs{} {}
+
+        template <typename weight_function>
+        void
+        assign(const std::size_t n, const weight_function& weight)
+        /// Builds the table for weights weight(0) to weight(n - 1).
+        {
+            if (n == 0)
+                {
+                    throw std::invalid_argument("number of weights must be > 0");
+                }
+            E.resize(n);
+            double total = 0.0;
+            for (std::size_t k = 0; k < n; ++k)
+                {
+                    E[k] = weight(k);
+                    if (!(E[k] >= 0.0))
+                        {
+                            throw std::invalid_argument(
+                                "weights must be non-negative");
+                        }
+                    total += E[k];
+                }
+            if (!std::isfinite(total))
+                {
+                    throw std::invalid_argument("weights must be finite");
+                }
+            build(total);
+        }
+
+        void
+        assign(const std::vector<double>& weights)
+        {
+            assign(weights.size(),
+                   [&weights](const std::size_t k) { return weights[k]; });
+        }
+
+        inline std::size_t
+        size() const
+        {
+            return F.size();
+        }
+
+        inline std::size_t
+        operator()(const GSLrng_t& rng) const
+        {
+            double u = gsl_rng_uniform(rng.get());
+            std::size_t c = static_cast<std::size_t>(u * F.size());
+            double f = F[c];
+            if (f == 1.0 || u < f)
+                {
+                    return c;
+                }
+            return A[c];
+        }
+
+        void
+        sample(const GSLrng_t& rng, const std::size_t n,
+               std::size_t* out) const
+        /// Fills out with n draws
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                {
+                    out[i] = this->operator()(rng);
+                }
+        }
+    };
+} // namespace fwdpy11
+
+#endif
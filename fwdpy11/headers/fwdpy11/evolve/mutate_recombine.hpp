@@ -0,0 +1,215 @@
+//
+// Copyright (C) 2017 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_EVOLVE_MUTATE_RECOMBINE_HPP__
+#define FWDPY11_EVOLVE_MUTATE_RECOMBINE_HPP__
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <fwdpp/forward_types.hpp>
+#include <fwdpp/internal/recycling.hpp>
+
+namespace fwdpy11
+{
+    namespace detail
+    {
+        template <typename key_iterator, typename mcont_t>
+        inline key_iterator
+        end_of_segment(key_iterator first, key_iterator last,
+                       const double breakpoint, const mcont_t& mutations)
+        /// Returns the first key whose position is > breakpoint.
+        /// Keys are sorted by position, so this is a binary search.
+        {
+            return std::upper_bound(
+                first, last, breakpoint,
+                [&mutations](const double bp, const fwdpp::uint_t key) {
+                    return bp < mutations[key].pos;
+                });
+        }
+
+        template <typename key_container, typename mcont_t>
+        inline void
+        insert_new_keys(const std::vector<fwdpp::uint_t>& new_mutations,
+                        const mcont_t& mutations, key_container& neutral,
+                        key_container& selected)
+        /// new_mutations must be sorted by position.
+        {
+            for (auto key : new_mutations)
+                {
+                    auto& keys = mutations[key].neutral ? neutral : selected;
+                    keys.insert(end_of_segment(keys.begin(), keys.end(),
+                                               mutations[key].pos, mutations),
+                                key);
+                }
+        }
+
+        struct no_gamete_observer
+        /// Used by mutate_recombine when no
+        /// per-gamete data need to be updated.
+        {
+            void
+            new_gamete(std::size_t)
+            {
+            }
+        };
+    } // namespace detail
+
+    enum class recombination_result : std::int8_t
+    /// Tells the caller of recombine_keys if the output
+    /// is identical to one of the two parental gametes.
+    {
+        first_gamete,
+        second_gamete,
+        new_gamete
+    };
+
+    template <typename key_container, typename mcont_t>
+    inline recombination_result
+    recombine_keys(const std::vector<double>& breakpoints,
+                   const key_container& first, const key_container& second,
+                   const mcont_t& mutations, key_container& output)
+    /// Fills output with the keys of a recombinant of first and second.
+    ///
+    /// The last value in breakpoints must be std::numeric_limits<double>::max().
+    /// As in fwdpp, keys at positions <= a breakpoint are inherited from
+    /// the "current" parental gamete.
+    ///
+    /// Each segment boundary is found by a binary search, and the keys
+    /// within a segment are copied as a single block.
+    {
+        output.clear();
+        auto b1 = first.cbegin(), e1 = first.cend();
+        auto b2 = second.cbegin(), e2 = second.cend();
+        bool same_as_first = true, same_as_second = true, from_first = true;
+        for (auto bp : breakpoints)
+            {
+                if (b1 == e1 && b2 == e2)
+                    {
+                        break;
+                    }
+                auto s1 = detail::end_of_segment(b1, e1, bp, mutations);
+                auto s2 = detail::end_of_segment(b2, e2, bp, mutations);
+                // The offspring inherits one of these two segments,
+                // and is unaffected by the choice if they are the same.
+                bool same_segment = (s1 - b1) == (s2 - b2)
+                                    && std::equal(b1, s1, b2);
+                if (from_first)
+                    {
+                        output.insert(output.end(), b1, s1);
+                        same_as_second = same_as_second && same_segment;
+                    }
+                else
+                    {
+                        output.insert(output.end(), b2, s2);
+                        same_as_first = same_as_first && same_segment;
+                    }
+                b1 = s1;
+                b2 = s2;
+                from_first = !from_first;
+            }
+        if (same_as_first)
+            {
+                return recombination_result::first_gamete;
+            }
+        if (same_as_second)
+            {
+                return recombination_result::second_gamete;
+            }
+        return recombination_result::new_gamete;
+    }
+
+    template <typename gcont_t, typename mcont_t, typename queue_t,
+              typename observer_t>
+    std::size_t
+    mutate_recombine(
+        const std::vector<fwdpp::uint_t>& new_mutations,
+        const std::vector<double>& breakpoints, const std::size_t g1,
+        const std::size_t g2, gcont_t& gametes, const mcont_t& mutations,
+        queue_t& gamete_recycling_bin,
+        typename gcont_t::value_type::mutation_container& neutral,
+        typename gcont_t::value_type::mutation_container& selected,
+        observer_t& observer)
+    /// Generate an offspring gamete from parental gametes g1 and g2.
+    ///
+    /// This function replaces fwdpp::mutate_recombine in fwdpy11's
+    /// evolve functions, and has the same interface and semantics.
+    /// new_mutations must be sorted by position, and breakpoints must
+    /// be empty or sorted and terminated by std::numeric_limits<double>::max().
+    ///
+    /// The return value is the index of the offspring gamete, which will be
+    /// g1 or g2 whenever the offspring is identical to a parental gamete.
+    /// The caller is responsible for incrementing the gamete's count.
+    ///
+    /// If a new gamete is created, observer.new_gamete is called with
+    /// its index, so that data kept for each gamete, such as those of a
+    /// haploid_effects_cache, can be discarded.
+    {
+        const bool recombines = !breakpoints.empty() && g1 != g2;
+        if (!recombines)
+            {
+                if (new_mutations.empty())
+                    {
+                        return g1;
+                    }
+                neutral.assign(gametes[g1].mutations.cbegin(),
+                               gametes[g1].mutations.cend());
+                selected.assign(gametes[g1].smutations.cbegin(),
+                                gametes[g1].smutations.cend());
+            }
+        else
+            {
+                auto rn = recombine_keys(breakpoints, gametes[g1].mutations,
+                                         gametes[g2].mutations, mutations,
+                                         neutral);
+                auto rs = recombine_keys(breakpoints, gametes[g1].smutations,
+                                         gametes[g2].smutations, mutations,
+                                         selected);
+                if (new_mutations.empty() && rn == rs
+                    && rn != recombination_result::new_gamete)
+                    {
+                        return (rn == recombination_result::first_gamete)
+                                   ? g1
+                                   : g2;
+                    }
+            }
+        detail::insert_new_keys(new_mutations, mutations, neutral, selected);
+        auto rv = fwdpp::fwdpp_internal::recycle_gamete(
+            gametes, gamete_recycling_bin, neutral, selected);
+        observer.new_gamete(rv);
+        return rv;
+    }
+
+    template <typename gcont_t, typename mcont_t, typename queue_t>
+    std::size_t
+    mutate_recombine(
+        const std::vector<fwdpp::uint_t>& new_mutations,
+        const std::vector<double>& breakpoints, const std::size_t g1,
+        const std::size_t g2, gcont_t& gametes, const mcont_t& mutations,
+        queue_t& gamete_recycling_bin,
+        typename gcont_t::value_type::mutation_container& neutral,
+        typename gcont_t::value_type::mutation_container& selected)
+    {
+        detail::no_gamete_observer no_observer;
+        return mutate_recombine(new_mutations, breakpoints, g1, g2, gametes,
+                                mutations, gamete_recycling_bin, neutral,
+                                selected, no_observer);
+    }
+} // namespace fwdpy11
+
+#endif
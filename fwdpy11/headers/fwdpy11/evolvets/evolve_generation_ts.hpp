@@ -22,32 +22,162 @@
 #define FWDPY11_EVOLVE_GENERATION_TS
 
 #include <cstdint>
+#include <cassert>
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <tuple>
 #include <gsl/gsl_randist.h>
 
 #include <fwdpp/util.hpp>
-#include <fwdpp/mutate_recombine.hpp>
-#include <fwdpp/ts/generate_offspring.hpp>
+#include <fwdpp/debug.hpp>
+#include <fwdpp/simfunctions/recycling.hpp>
 #include <fwdpp/ts/get_parent_ids.hpp>
 #include <fwdpp/ts/table_collection.hpp>
 #include <fwdpp/ts/table_simplifier.hpp>
+#include <fwdpy11/evolve/mutate_recombine.hpp>
 
 namespace fwdpy11
 {
+    namespace generation_policies
+    /// Tag types used to compile specialized versions of
+    /// evolve_generation_ts.  When a model is known to have
+    /// no recombination or no new mutations, the corresponding
+    /// callbacks are never invoked.
+    {
+        struct recombination
+        {
+        };
+        struct no_recombination
+        {
+        };
+        struct mutation
+        {
+        };
+        struct no_mutation
+        {
+        };
+    } // namespace generation_policies
+
+    template <typename genetic_param_holder>
+    inline std::vector<double>
+    generate_breakpoints(genetic_param_holder& genetics,
+                         generation_policies::recombination)
+    {
+        return genetics.generate_breakpoints();
+    }
+
+    template <typename genetic_param_holder>
+    inline std::vector<double>
+    generate_breakpoints(genetic_param_holder& /*genetics*/,
+                         generation_policies::no_recombination)
+    {
+        return {};
+    }
 
-    template <typename poptype, typename rng_t, typename genetic_param_holder>
-    std::pair<fwdpp::ts::mut_rec_intermediates,
-              fwdpp::ts::mut_rec_intermediates>
+    template <typename poptype, typename genetic_param_holder>
+    inline std::vector<fwdpp::uint_t>
+    generate_mutations(poptype& pop, genetic_param_holder& genetics,
+                       generation_policies::mutation)
+    {
+        return genetics.generate_mutations(genetics.mutation_recycling_bin,
+                                           pop.mutations);
+    }
+
+    template <typename poptype, typename genetic_param_holder>
+    inline std::vector<fwdpp::uint_t>
+    generate_mutations(poptype& /*pop*/, genetic_param_holder& /*genetics*/,
+                       generation_policies::no_mutation)
+    {
+        return {};
+    }
+
+    inline bool
+    node_table_has_capacity(
+        const std::int64_t next_index, const std::int64_t num_new_nodes,
+        const std::int64_t max_node_id
+        = std::numeric_limits<fwdpp::ts::TS_NODE_INT>::max())
+    /// Returns true if num_new_nodes, starting at next_index,
+    /// can be assigned IDs no larger than max_node_id.
+    /// max_node_id must not exceed the maximum value of
+    /// fwdpp::ts::TS_NODE_INT.
+    {
+        return next_index + num_new_nodes - 1 <= max_node_id;
+    }
+
+    struct offspring_gamete_data
+    /// The data needed to record the transmission
+    /// of an offspring gamete into a table collection.
+    {
+        int swapped;
+        std::vector<double> breakpoints;
+        // Keys of new selected mutations
+        std::vector<fwdpp::uint_t> mutation_keys;
+    };
+
+    template <typename recombination_policy, typename mutation_policy,
+              typename poptype, typename genetic_param_holder>
+    inline offspring_gamete_data
+    generate_offspring_gamete(const std::size_t g1, const std::size_t g2,
+                              const int swapped, poptype& pop,
+                              genetic_param_holder& genetics,
+                              std::size_t& offspring_gamete)
+    {
+        auto breakpoints
+            = generate_breakpoints(genetics, recombination_policy());
+        auto new_mutations
+            = generate_mutations(pop, genetics, mutation_policy());
+        offspring_gamete = fwdpy11::mutate_recombine(
+            new_mutations, breakpoints, g1, g2, pop.gametes, pop.mutations,
+            genetics.gamete_recycling_bin, genetics.neutral,
+            genetics.selected);
+        pop.gametes[offspring_gamete].n++;
+        // Only selected variants are recorded in the tables
+        new_mutations.erase(
+            std::remove_if(new_mutations.begin(), new_mutations.end(),
+                           [&pop](const fwdpp::uint_t key) {
+                               return pop.mutations[key].neutral;
+                           }),
+            new_mutations.end());
+        return offspring_gamete_data{ swapped, std::move(breakpoints),
+                                      std::move(new_mutations) };
+    }
+
+    template <typename recombination_policy
+              = generation_policies::recombination,
+              typename mutation_policy = generation_policies::mutation,
+              typename poptype, typename rng_t, typename genetic_param_holder>
+    std::pair<offspring_gamete_data, offspring_gamete_data>
     generate_offspring(
         const rng_t& rng,
         const std::pair<std::size_t, std::size_t> parent_indexes, poptype& pop,
         typename poptype::diploid_t& offspring, genetic_param_holder& genetics)
     {
-        auto offspring_data = fwdpp::ts::generate_offspring(
-            rng.get(), parent_indexes, fwdpp::ts::selected_variants_only(),
-            pop, genetics, offspring);
+        auto p1g1 = pop.diploids[parent_indexes.first].first;
+        auto p1g2 = pop.diploids[parent_indexes.first].second;
+        auto p2g1 = pop.diploids[parent_indexes.second].first;
+        auto p2g2 = pop.diploids[parent_indexes.second].second;
+        int swap1 = (gsl_rng_uniform(rng.get()) < 0.5) ? 1 : 0;
+        int swap2 = (gsl_rng_uniform(rng.get()) < 0.5) ? 1 : 0;
+        if (swap1)
+            {
+                std::swap(p1g1, p1g2);
+            }
+        if (swap2)
+            {
+                std::swap(p2g1, p2g2);
+            }
+        // Separate statements guarantee the order of random number draws
+        auto data1
+            = generate_offspring_gamete<recombination_policy, mutation_policy>(
+                p1g1, p1g2, swap1, pop, genetics, offspring.first);
+        auto data2
+            = generate_offspring_gamete<recombination_policy, mutation_policy>(
+                p2g1, p2g2, swap2, pop, genetics, offspring.second);
+        auto offspring_data
+            = std::make_pair(std::move(data1), std::move(data2));
 #ifndef NDEBUG
         for (auto& m : offspring_data.first.mutation_keys)
             {
@@ -63,7 +193,10 @@ namespace fwdpy11
         return offspring_data;
     }
 
-    template <typename rng_t, typename poptype, typename pick_parent1_fxn,
+    template <typename recombination_policy
+              = generation_policies::recombination,
+              typename mutation_policy = generation_policies::mutation,
+              typename rng_t, typename poptype, typename pick_parent1_fxn,
               typename pick_parent2_fxn, typename offspring_metadata_fxn,
               typename genetic_param_holder>
     void
@@ -73,16 +206,35 @@ namespace fwdpy11
         const pick_parent2_fxn& pick2,
         const offspring_metadata_fxn& update_offspring,
         const fwdpp::uint_t generation, fwdpp::ts::table_collection& tables,
-        std::int32_t first_parental_index, std::int32_t next_index)
+        fwdpp::ts::TS_NODE_INT first_parental_index,
+        fwdpp::ts::TS_NODE_INT next_index,
+        decltype(pop.diploids)& offspring,
+        decltype(pop.diploid_metadata)& offspring_metadata,
+        const std::int64_t max_node_id
+        = std::numeric_limits<fwdpp::ts::TS_NODE_INT>::max())
+    /// offspring and offspring_metadata are workspace. After
+    /// this function returns, they contain the parental generation.
+    /// Re-using them across generations means that no allocation
+    /// happens when the population size is constant.
+    /// See node_table_has_capacity for max_node_id.
     {
+        if (!node_table_has_capacity(next_index, 2 * std::int64_t(N_next),
+                                     max_node_id))
+            {
+                throw std::overflow_error(
+                    "generation " + std::to_string(generation)
+                    + " would need node IDs beyond the maximum of "
+                    + std::to_string(max_node_id)
+                    + ", even after simplification");
+            }
         fwdpp::debug::all_gametes_extant(pop);
 
         genetics.gamete_recycling_bin = fwdpp::make_gamete_queue(pop.gametes);
 
         fwdpp::zero_out_gametes(pop);
 
-        decltype(pop.diploids) offspring(N_next);
-        decltype(pop.diploid_metadata) offspring_metadata(N_next);
+        offspring.resize(N_next);
+        offspring_metadata.resize(N_next);
 
         // Generate the offspring
         auto next_index_local = next_index;
@@ -92,8 +244,10 @@ namespace fwdpy11
                 auto p1 = pick1();
                 auto p2 = pick2(p1);
                 auto& dip = offspring[next_offspring];
-                auto offspring_data = generate_offspring(
-                    rng, std::make_pair(p1, p2), pop, dip, genetics);
+                auto offspring_data
+                    = generate_offspring<recombination_policy,
+                                         mutation_policy>(
+                        rng, std::make_pair(p1, p2), pop, dip, genetics);
                 auto p1id = fwdpp::ts::get_parent_ids(
                     first_parental_index, p1, offspring_data.first.swapped);
                 auto p2id = fwdpp::ts::get_parent_ids(
@@ -108,6 +262,7 @@ namespace fwdpy11
                 // Give the caller a chance to generate
                 // any metadata for the offspring that
                 // may depend on the parents
+                offspring_metadata[next_offspring] = {};
                 offspring_metadata[next_offspring].label = next_offspring;
                 update_offspring(offspring_metadata[next_offspring], p1, p2,
                                  pop.diploid_metadata);
@@ -118,7 +273,8 @@ namespace fwdpy11
                     = next_index_local - 1;
             }
         assert(next_index_local
-               == next_index + 2 * static_cast<std::int32_t>(N_next));
+               == next_index
+                      + 2 * static_cast<fwdpp::ts::TS_NODE_INT>(N_next));
         // This is constant-time
         pop.diploids.swap(offspring);
         pop.diploid_metadata.swap(offspring_metadata);
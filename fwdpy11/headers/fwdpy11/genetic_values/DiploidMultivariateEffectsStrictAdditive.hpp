@@ -1,12 +1,14 @@
 #ifndef FWDPY11_POP_MULTIVARIATE_STRICT_ADDITIVE_HPP
 #define FWDPY11_POP_MULTIVARIATE_STRICT_ADDITIVE_HPP
 
+#include <cstdint>
 #include <vector>
 #include <stdexcept>
 #include <algorithm>
 #include <functional>
 #include "DiploidPopulationMultivariateGeneticValueWithMapping.hpp"
-#include "default_update.hpp"
+#include "details/effect_size_matrix.hpp"
+#include "details/sparse_effect_sizes.hpp"
 
 namespace fwdpy11
 {
@@ -14,12 +16,31 @@ namespace fwdpy11
         : public DiploidPopulationMultivariateGeneticValueWithMapping
     {
         std::size_t focal_trait_index;
+        /// Filled by update and used by evaluate_population.
+        /// Only one of effect_sizes and sparse_effects is kept,
+        /// depending on the fraction of non-zero effect sizes.
+        mutable effect_size_matrix effect_sizes;
+        mutable sparse_effect_sizes sparse_effects;
+        mutable bool use_sparse_effects;
+        /// The serial number of the population and the value of its
+        /// effect_size_changes when the effect sizes were last filled.
+        mutable std::uint64_t filled_from;
+        mutable std::uint64_t filled_effect_size_changes;
+        /// Sparse storage is used when at most this fraction
+        /// of the effect sizes are non-zero.
+        static constexpr double max_sparse_density = 0.25;
+        /// Trait values of all individuals, used by evaluate_population
+        /// when the caller does not request them.
+        mutable std::vector<double> population_values;
 
         DiploidMultivariateEffectsStrictAdditive(
             std::size_t ndim, std::size_t focal_trait,
             const MultivariateGeneticValueToFitnessMap &gv2w_)
             : DiploidPopulationMultivariateGeneticValueWithMapping(ndim, gv2w_),
-              focal_trait_index(focal_trait)
+              focal_trait_index(focal_trait), effect_sizes(ndim),
+              sparse_effects(ndim), use_sparse_effects(false),
+              filled_from(0), filled_effect_size_changes(0),
+              population_values{}
         {
         }
 
@@ -29,44 +50,181 @@ namespace fwdpy11
             const GeneticValueNoise &noise_)
             : DiploidPopulationMultivariateGeneticValueWithMapping(ndim, gv2w_,
                                                            noise_),
-              focal_trait_index(focal_trait)
+              focal_trait_index(focal_trait), effect_sizes(ndim),
+              sparse_effects(ndim), use_sparse_effects(false),
+              filled_from(0), filled_effect_size_changes(0),
+              population_values{}
         {
         }
 
+        template <typename accumulate_fxn>
+        inline double
+        sum_effect_sizes(const DiploidGenotype &dip,
+                         const DiploidPopulation &pop,
+                         const accumulate_fxn &accumulate) const
+        /// Sets gvalues to the sum of the effect sizes of the
+        /// mutations on both gametes of dip, and returns the
+        /// value of the focal trait.  accumulate(key, output)
+        /// adds the effect sizes of mutation key to output.
+        /// Used by both calculate_gvalue and evaluate_population.
+        {
+            std::fill(begin(gvalues), end(gvalues), 0.0);
+            for (auto key : pop.gametes[dip.first].smutations)
+                {
+                    accumulate(key, gvalues.data());
+                }
+            for (auto key : pop.gametes[dip.second].smutations)
+                {
+                    accumulate(key, gvalues.data());
+                }
+            return gvalues[focal_trait_index];
+        }
+
         double
         calculate_gvalue(const std::size_t diploid_index,
                          const DiploidPopulation &pop) const
+        /// Effect sizes are read from the mutations, because
+        /// effect_sizes and sparse_effects may be out of date
+        /// when called from Python.
         {
-            std::fill(begin(gvalues), end(gvalues), 0.0);
-
-            for (auto key :
-                 pop.gametes[pop.diploids[diploid_index].first].smutations)
-                {
-                    const auto &mut = pop.mutations[key];
-                    if (mut.esizes.size() != gvalues.size())
+            const auto ndim = total_dim;
+            return sum_effect_sizes(
+                pop.diploids[diploid_index], pop,
+                [&pop, ndim](const fwdpp::uint_t key, double *output) {
+                    const auto &esizes = pop.mutations[key].esizes;
+                    if (esizes.size() != ndim)
                         {
                             throw std::runtime_error(
                                 "dimensionality mismatch");
                         }
-                    std::transform(begin(mut.esizes), end(mut.esizes),
-                                   begin(gvalues), begin(gvalues),
-                                   std::plus<double>());
-                }
+                    accumulate_effect_sizes(esizes.data(), ndim, output);
+                });
+        }
 
-            for (auto key :
-                 pop.gametes[pop.diploids[diploid_index].second].smutations)
+        void
+        fill_effect_sizes(const DiploidPopulation &pop) const
+        /// While sparse storage remains adequate for the same
+        /// population, it is updated for new and recycled keys.
+        /// Otherwise, the non-zero effect sizes are counted,
+        /// and only the chosen layout is filled.
+        {
+            const bool same_effects
+                = filled_from == pop.serial.value
+                  && filled_effect_size_changes == pop.effect_size_changes;
+            filled_from = pop.serial.value;
+            filled_effect_size_changes = pop.effect_size_changes;
+            if (use_sparse_effects && same_effects)
                 {
-                    const auto &mut = pop.mutations[key];
-                    if (mut.esizes.size() != gvalues.size())
+                    sparse_effects.update(pop.mutations);
+                    if (sparse_effects.density() <= max_sparse_density)
                         {
-                            throw std::runtime_error(
-                                "dimensionality mismatch");
+                            return;
                         }
-                    std::transform(begin(mut.esizes), end(mut.esizes),
-                                   begin(gvalues), begin(gvalues),
-                                   std::plus<double>());
                 }
-            return gvalues[focal_trait_index];
+            use_sparse_effects
+                = sparse_effect_sizes::density(
+                      sparse_effect_sizes::count_nonzero(pop.mutations,
+                                                         total_dim),
+                      pop.mutations.size(), total_dim)
+                  <= max_sparse_density;
+            if (use_sparse_effects)
+                {
+                    effect_sizes.clear();
+                    sparse_effects.fill(pop.mutations);
+                }
+            else
+                {
+                    sparse_effects.clear();
+                    effect_sizes.fill(pop.mutations);
+                }
+        }
+
+        inline std::size_t
+        effect_sizes_nrows() const
+        {
+            return use_sparse_effects ? sparse_effects.nrows()
+                                      : effect_sizes.nrows();
+        }
+
+        template <typename accumulate_fxn>
+        void
+        evaluate_trait_values(const GSLrng_t &rng,
+                              const DiploidPopulation &pop,
+                              std::vector<DiploidMetadata> &metadata,
+                              double *values,
+                              const accumulate_fxn &accumulate) const
+        /// Fills the trait values, g, and e of all diploids.
+        {
+            for (std::size_t i = 0; i < pop.diploids.size(); ++i)
+                {
+                    auto &md = metadata[i];
+                    md.g = sum_effect_sizes(pop.diploids[i], pop, accumulate);
+                    md.e = noise_fxn->operator()(rng, md, md.parents[0],
+                                                 md.parents[1], pop);
+                    std::copy(begin(gvalues), end(gvalues),
+                              values + i * total_dim);
+                }
+        }
+
+        void
+        evaluate_population(const GSLrng_t &rng, const DiploidPopulation &pop,
+                            std::vector<DiploidMetadata> &metadata,
+                            double *genetic_values) const override
+        /// Unlike calculate_gvalue, effect sizes are read
+        /// from effect_sizes or sparse_effects.  All trait values are
+        /// obtained before fitness, which is then calculated for
+        /// the whole population via gv2w->evaluate_population.
+        {
+            if (effect_sizes_nrows() != pop.mutations.size())
+                {
+                    fill_effect_sizes(pop);
+                }
+            const auto N = pop.diploids.size();
+            double *values = genetic_values;
+            if (values == nullptr)
+                {
+                    population_values.resize(N * total_dim);
+                    values = population_values.data();
+                }
+            if (use_sparse_effects)
+                {
+                    const auto &effects = sparse_effects;
+                    evaluate_trait_values(
+                        rng, pop, metadata, values,
+                        [&effects](const fwdpp::uint_t key, double *output) {
+                            if (!effects.valid[key])
+                                {
+                                    throw std::runtime_error(
+                                        "dimensionality mismatch");
+                                }
+                            effects.accumulate(key, output);
+                        });
+                }
+            else
+                {
+                    const auto &effects = effect_sizes;
+                    const auto ndim = total_dim;
+                    evaluate_trait_values(
+                        rng, pop, metadata, values,
+                        [&effects, ndim](const fwdpp::uint_t key,
+                                         double *output) {
+                            if (!effects.valid[key])
+                                {
+                                    throw std::runtime_error(
+                                        "dimensionality mismatch");
+                                }
+                            accumulate_effect_sizes(effects.row(key), ndim,
+                                                    output);
+                        });
+                }
+            gv2w->evaluate_population(metadata, values, N, total_dim);
+        }
+
+        void
+        update(const DiploidPopulation &pop) override
+        {
+            DiploidPopulationMultivariateGeneticValueWithMapping::update(pop);
+            fill_effect_sizes(pop);
         }
 
         pybind11::object
@@ -0,0 +1,260 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_GENETIC_VALUES_PAIRWISE_EPISTASIS_HPP__
+#define FWDPY11_GENETIC_VALUES_PAIRWISE_EPISTASIS_HPP__
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <fwdpp/fitness_models.hpp>
+#include "DiploidPopulationGeneticValueWithMapping.hpp"
+
+namespace fwdpy11
+{
+    struct epistatic_interaction_index
+    /// Sparse index of pairwise interactions between mutation labels.
+    /// Each pair (a, b), a < b, is stored once, in CSR form:
+    /// the partners of label a are partners[offsets[a]] to
+    /// partners[offsets[a + 1] - 1], with effects in the same
+    /// positions of effects.
+    {
+        using interaction = std::tuple<std::uint16_t, std::uint16_t, double>;
+        std::vector<std::size_t> offsets;
+        std::vector<std::uint16_t> partners;
+        std::vector<double> effects;
+
+        explicit epistatic_interaction_index(
+            std::vector<interaction> interactions)
+            : offsets{}, partners{}, effects{}
+        {
+            std::uint16_t max_label = 0;
+            for (auto& i : interactions)
+                {
+                    auto& a = std::get<0>(i);
+                    auto& b = std::get<1>(i);
+                    if (a == b)
+                        {
+                            throw std::invalid_argument(
+                                "a label cannot interact with itself");
+                        }
+                    if (a == 0 || b == 0)
+                        {
+                            throw std::invalid_argument(
+                                "label 0 cannot be used for interactions");
+                        }
+                    if (b < a)
+                        {
+                            std::swap(a, b);
+                        }
+                    max_label = std::max(max_label, b);
+                }
+            std::sort(begin(interactions), end(interactions));
+            if (std::adjacent_find(
+                    begin(interactions), end(interactions),
+                    [](const interaction& x, const interaction& y) {
+                        return std::get<0>(x) == std::get<0>(y)
+                               && std::get<1>(x) == std::get<1>(y);
+                    })
+                != end(interactions))
+                {
+                    throw std::invalid_argument("duplicate interaction");
+                }
+            offsets.resize(interactions.empty() ? 0 : max_label + 2, 0);
+            for (auto& i : interactions)
+                {
+                    ++offsets[std::get<0>(i) + 1];
+                    partners.push_back(std::get<1>(i));
+                    effects.push_back(std::get<2>(i));
+                }
+            std::partial_sum(begin(offsets), end(offsets), begin(offsets));
+        }
+
+        inline std::size_t
+        nlabels() const
+        /// One more than the largest label in the index
+        {
+            return offsets.empty() ? 0 : offsets.size() - 1;
+        }
+
+        std::vector<interaction>
+        interactions() const
+        {
+            std::vector<interaction> rv;
+            for (std::size_t a = 0; a < nlabels(); ++a)
+                {
+                    for (auto j = offsets[a]; j < offsets[a + 1]; ++j)
+                        {
+                            rv.emplace_back(static_cast<std::uint16_t>(a),
+                                            partners[j], effects[j]);
+                        }
+                }
+            return rv;
+        }
+    };
+
+    struct DiploidPairwiseEpistasis
+        : public DiploidPopulationGeneticValueWithMapping
+    /// Additive effects plus pairwise epistasis between mutation labels.
+    ///
+    /// The genetic value is the additive value (see fwdpp::additive_diploid)
+    /// plus the sum of e_ab * c_a * c_b over interacting labels a and b,
+    /// where c_a is the number of copies of selected mutations with
+    /// label a in a diploid.  Labels are assigned to mutations at the
+    /// time they arise, via the label of their Sregion.
+    ///
+    /// The effect e_ab is fixed for each pair of labels when the model
+    /// is constructed.  It is not drawn for each new mutation, which
+    /// would need an effect for every pair of segregating mutations.
+    /// Mutations that should interact differently need different labels.
+    ///
+    /// The cost of evaluating a diploid is linear in the number of its
+    /// mutations plus the number of interactions of the labels present.
+    {
+        const fwdpp::additive_diploid additive;
+        const bool is_fitness;
+        const epistatic_interaction_index index;
+        // Number of copies of each label, and
+        // the labels present, in the current diploid
+        mutable std::vector<unsigned> label_counts;
+        mutable std::vector<std::uint16_t> present_labels;
+
+        DiploidPairwiseEpistasis(
+            double scaling,
+            std::vector<epistatic_interaction_index::interaction> interactions)
+            : DiploidPopulationGeneticValueWithMapping(GeneticValueIsFitness()),
+              additive(fwdpp::trait(scaling)), is_fitness(true),
+              index(std::move(interactions)),
+              label_counts(index.nlabels(), 0), present_labels{}
+        {
+        }
+
+        DiploidPairwiseEpistasis(
+            double scaling,
+            std::vector<epistatic_interaction_index::interaction> interactions,
+            const GeneticValueToFitnessMap& gv2w_)
+            : DiploidPopulationGeneticValueWithMapping(gv2w_),
+              additive(fwdpp::trait(scaling)), is_fitness(false),
+              index(std::move(interactions)),
+              label_counts(index.nlabels(), 0), present_labels{}
+        {
+        }
+
+        DiploidPairwiseEpistasis(
+            double scaling,
+            std::vector<epistatic_interaction_index::interaction> interactions,
+            const GeneticValueToFitnessMap& gv2w_,
+            const GeneticValueNoise& noise_)
+            : DiploidPopulationGeneticValueWithMapping(gv2w_, noise_),
+              additive(fwdpp::trait(scaling)), is_fitness(false),
+              index(std::move(interactions)),
+              label_counts(index.nlabels(), 0), present_labels{}
+        {
+        }
+
+        template <typename key_container>
+        inline void
+        count_labels(const key_container& keys,
+                     const std::vector<Mutation>& mutations) const
+        {
+            for (auto key : keys)
+                {
+                    auto label = mutations[key].xtra;
+                    if (label < label_counts.size())
+                        {
+                            if (label_counts[label]++ == 0)
+                                {
+                                    present_labels.push_back(label);
+                                }
+                        }
+                }
+        }
+
+        double
+        epistatic_value(const DiploidGenotype& dip,
+                        const DiploidPopulation& pop) const
+        {
+            if (index.partners.empty())
+                {
+                    return 0.0;
+                }
+            count_labels(pop.gametes[dip.first].smutations, pop.mutations);
+            count_labels(pop.gametes[dip.second].smutations, pop.mutations);
+            double rv = 0.0;
+            for (auto a : present_labels)
+                {
+                    for (auto j = index.offsets[a]; j < index.offsets[a + 1];
+                         ++j)
+                        {
+                            rv += index.effects[j] * label_counts[a]
+                                  * label_counts[index.partners[j]];
+                        }
+                }
+            for (auto a : present_labels)
+                {
+                    label_counts[a] = 0;
+                }
+            present_labels.clear();
+            return rv;
+        }
+
+        double
+        calculate_gvalue(const std::size_t diploid_index,
+                         const DiploidPopulation& pop) const
+        {
+            const auto& dip = pop.diploids[diploid_index];
+            double g = additive(dip, pop.gametes, pop.mutations)
+                       + epistatic_value(dip, pop);
+            gvalues[0] = is_fitness ? std::max(0.0, 1.0 + g) : g;
+            return gvalues[0];
+        }
+
+        bool
+        supports_parallel_evaluation() const override
+        /// calculate_gvalue counts labels in label_counts and
+        /// present_labels, which are shared by all calls, so it
+        /// cannot be called from more than one thread.
+        {
+            return false;
+        }
+
+        void
+        update(const DiploidPopulation& pop)
+        {
+            gv2w->update(pop);
+            noise_fxn->update(pop);
+        }
+
+        pybind11::object
+        pickle() const
+        {
+            pybind11::list l;
+            for (auto& i : index.interactions())
+                {
+                    l.append(pybind11::make_tuple(
+                        std::get<0>(i), std::get<1>(i), std::get<2>(i)));
+                }
+            return pybind11::make_tuple(additive.scaling, is_fitness, l);
+        }
+    };
+} // namespace fwdpy11
+
+#endif
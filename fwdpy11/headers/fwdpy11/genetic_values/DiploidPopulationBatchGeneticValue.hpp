@@ -0,0 +1,184 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_POP_BATCH_GENETIC_VALUE_HPP__
+#define FWDPY11_POP_BATCH_GENETIC_VALUE_HPP__
+
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include "DiploidPopulationGeneticValueWithMapping.hpp"
+
+namespace fwdpy11
+{
+    struct BatchGeneticValueData
+    /// The data passed to
+    /// DiploidPopulationBatchGeneticValue::batch_gvalues.
+    /// The selected mutation keys of all gametes are stored
+    /// contiguously: the keys of gamete i are
+    /// keys[offsets[i]] to keys[offsets[i + 1] - 1].
+    /// All other data are references to the population
+    /// and the offspring metadata, which are only valid
+    /// during the call to batch_gvalues.
+    {
+        std::vector<fwdpp::uint_t> keys;
+        std::vector<std::size_t> offsets;
+        const DiploidPopulation* pop;
+        const std::vector<DiploidMetadata>* metadata;
+
+        BatchGeneticValueData()
+            : keys{}, offsets{}, pop(nullptr), metadata(nullptr)
+        {
+        }
+
+        void
+        fill(const DiploidPopulation& p,
+             const std::vector<DiploidMetadata>& md)
+        {
+            pop = &p;
+            metadata = &md;
+            keys.clear();
+            offsets.resize(p.gametes.size() + 1);
+            offsets[0] = 0;
+            for (std::size_t i = 0; i < p.gametes.size(); ++i)
+                {
+                    keys.insert(end(keys), begin(p.gametes[i].smutations),
+                                end(p.gametes[i].smutations));
+                    offsets[i + 1] = keys.size();
+                }
+        }
+
+        void
+        clear()
+        {
+            pop = nullptr;
+            metadata = nullptr;
+        }
+    };
+
+    struct DiploidPopulationBatchGeneticValue
+        : public DiploidPopulationGeneticValueWithMapping
+    /// API class for genetic value models written in Python.
+    /// The genetic values of all individuals are obtained from
+    /// one call to batch_gvalues per generation, which is
+    /// overridden in Python.  Genetic values are only calculated
+    /// by evaluate_population, so calculate_gvalue throws.
+    {
+        mutable BatchGeneticValueData data;
+
+        explicit DiploidPopulationBatchGeneticValue(
+            const GeneticValueToFitnessMap& gv2w_)
+            : DiploidPopulationGeneticValueWithMapping(gv2w_), data{}
+        {
+        }
+
+        DiploidPopulationBatchGeneticValue(
+            const GeneticValueToFitnessMap& gv2w_,
+            const GeneticValueNoise& noise_)
+            : DiploidPopulationGeneticValueWithMapping(gv2w_, noise_), data{}
+        {
+        }
+
+        /// Return the genetic value of each diploid in data.pop
+        virtual pybind11::array_t<double>
+        batch_gvalues(const BatchGeneticValueData& data) const = 0;
+
+        pybind11::array_t<double>
+        call_batch_gvalues(const DiploidPopulation& pop,
+                           const std::vector<DiploidMetadata>& metadata) const
+        {
+            data.fill(pop, metadata);
+            pybind11::array_t<double> rv;
+            try
+                {
+                    rv = batch_gvalues(data);
+                }
+            catch (...)
+                {
+                    data.clear();
+                    throw;
+                }
+            data.clear();
+            if (rv.ndim() != 1
+                || static_cast<std::size_t>(rv.shape(0))
+                       != pop.diploids.size())
+                {
+                    throw std::runtime_error(
+                        "batch_gvalues must return one value per diploid");
+                }
+            return rv;
+        }
+
+        double
+        calculate_gvalue(const std::size_t /*diploid_index*/,
+                         const DiploidPopulation& /*pop*/) const
+        /// Evaluating one diploid would require calling
+        /// batch_gvalues for the entire population.
+        {
+            throw std::runtime_error(
+                "BatchGeneticValue cannot evaluate single individuals; "
+                "genetic values are stored in the diploid metadata");
+        }
+
+        void
+        evaluate_population(const GSLrng_t& rng, const DiploidPopulation& pop,
+                            std::vector<DiploidMetadata>& metadata,
+                            double* genetic_values) const override
+        {
+            auto rv = call_batch_gvalues(pop, metadata);
+            auto g = rv.unchecked<1>();
+            const auto N = pop.diploids.size();
+            for (std::size_t i = 0; i < N; ++i)
+                {
+                    metadata[i].g = g(i);
+                    if (!std::isfinite(metadata[i].g))
+                        {
+                            throw std::runtime_error(
+                                "non-finite genetic value");
+                        }
+                }
+            noise_fxn->generate(rng, metadata, 0, N, pop);
+            for (std::size_t i = 0; i < N; ++i)
+                {
+                    auto& md = metadata[i];
+                    md.w = gv2w->operator()(md);
+                    if (genetic_values != nullptr)
+                        {
+                            genetic_values[i] = md.g;
+                        }
+                }
+        }
+
+        void
+        update(const DiploidPopulation& pop)
+        {
+            gv2w->update(pop);
+            noise_fxn->update(pop);
+        }
+
+        pybind11::object
+        pickle() const
+        {
+            return pybind11::none();
+        }
+    };
+} // namespace fwdpy11
+
+#endif
@@ -21,11 +21,14 @@
 
 #include <cstdint>
 #include <vector>
+#include <algorithm>
+#include <stdexcept>
 #include <pybind11/pybind11.h>
 #include <fwdpy11/rng.hpp>
 #include <fwdpy11/types/DiploidPopulation.hpp>
 #include "GeneticValueToFitness.hpp"
 #include "noise.hpp"
+#include "details/haploid_effects_cache.hpp"
 
 namespace fwdpy11
 {
@@ -71,6 +74,67 @@ namespace fwdpy11
             metadata.w = genetic_value_to_fitness(metadata);
         }
 
+        /// Batch API: fills metadata[i].g, .e, and .w for all diploids,
+        /// in order.  If genetic_values is not nullptr, the total_dim
+        /// genetic values of diploid i are written to
+        /// genetic_values + i * total_dim.
+        /// The default applies operator() to each diploid.
+        /// Derived classes may override this with a loop that avoids
+        /// per-diploid virtual function calls, but noise must
+        /// be generated for diploids in index order.
+        virtual void
+        evaluate_population(const GSLrng_t& rng, const DiploidPopulation& pop,
+                            std::vector<DiploidMetadata>& metadata,
+                            double* genetic_values) const
+        {
+            for (std::size_t i = 0; i < pop.diploids.size(); ++i)
+                {
+                    this->operator()(rng, i, pop, metadata[i]);
+                    if (genetic_values != nullptr)
+                        {
+                            std::copy(begin(gvalues), end(gvalues),
+                                      genetic_values + i * total_dim);
+                        }
+                }
+        }
+
+        /// Returns true if evaluate_range may be called
+        /// concurrently for disjoint ranges of diploids.
+        /// This includes any calls that evaluate_range makes
+        /// to GeneticValueToFitnessMap and GeneticValueNoise
+        /// objects, which must return true from their own
+        /// supports_parallel_evaluation.
+        virtual bool
+        supports_parallel_evaluation() const
+        {
+            return false;
+        }
+
+        /// Same as evaluate_population, but only for diploids
+        /// first to last - 1.  Implementations must not write to
+        /// gvalues or any other shared state.  Only called when
+        /// supports_parallel_evaluation returns true.
+        virtual void
+        evaluate_range(const GSLrng_t& /*rng*/,
+                       const DiploidPopulation& /*pop*/,
+                       std::vector<DiploidMetadata>& /*metadata*/,
+                       double* /*genetic_values*/, std::size_t /*first*/,
+                       std::size_t /*last*/) const
+        {
+            throw std::runtime_error(
+                "genetic value does not support parallel evaluation");
+        }
+
+        /// Returns the per-gamete summaries used by the derived
+        /// class, or nullptr if it does not use them.  Evolve
+        /// functions that keep the returned object valid must
+        /// invalidate it when they return.
+        virtual haploid_effects_cache*
+        tracked_haploid_cache()
+        {
+            return nullptr;
+        }
+
         virtual double genetic_value_to_fitness(
             const DiploidMetadata& /*metadata*/) const = 0;
         virtual double noise(const GSLrng_t& /*rng*/,
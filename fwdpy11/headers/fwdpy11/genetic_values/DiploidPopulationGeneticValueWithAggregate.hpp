@@ -0,0 +1,166 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_POP_GENETIC_VALUE_WITH_AGGREGATE_HPP__
+#define FWDPY11_POP_GENETIC_VALUE_WITH_AGGREGATE_HPP__
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "DiploidPopulationGeneticValue.hpp"
+
+namespace fwdpy11
+{
+    struct GeneticValueMoments
+    /// Running summary of a set of values.
+    {
+        std::size_t n;
+        double sum, sum_squares, min, max;
+
+        GeneticValueMoments()
+            : n(0), sum(0.0), sum_squares(0.0),
+              min(std::numeric_limits<double>::max()),
+              max(std::numeric_limits<double>::lowest())
+        {
+        }
+
+        inline void
+        add(const double x)
+        {
+            ++n;
+            sum += x;
+            sum_squares += x * x;
+            min = std::min(min, x);
+            max = std::max(max, x);
+        }
+
+        inline double
+        mean() const
+        {
+            return n ? sum / static_cast<double>(n)
+                     : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        inline double
+        variance() const
+        /// Population (not sample) variance
+        {
+            if (!n)
+                {
+                    return std::numeric_limits<double>::quiet_NaN();
+                }
+            auto m = mean();
+            return std::max(sum_squares / static_cast<double>(n) - m * m,
+                            0.0);
+        }
+    };
+
+    struct PopulationAggregate
+    /// Reduction over all individuals of a generation.
+    {
+        /// Moments of genetic values, DiploidMetadata::g
+        GeneticValueMoments g;
+        /// Moments of phenotypes, DiploidMetadata::g + DiploidMetadata::e
+        GeneticValueMoments phenotype;
+
+        inline void
+        add(const DiploidMetadata& metadata)
+        {
+            g.add(metadata.g);
+            phenotype.add(metadata.g + metadata.e);
+        }
+    };
+
+    struct DiploidPopulationGeneticValueWithAggregate
+        : public DiploidPopulationGeneticValue
+    /// API class for models where an individual's fitness depends
+    /// on the genetic values of the entire population, such as
+    /// frequency-dependent selection.
+    ///
+    /// During a simulation, evaluate_population proceeds in two passes:
+    /// 1. calculate_gvalue and noise are called for each individual,
+    ///    the results are added to aggregate, and aggregate_individual
+    ///    is called to allow for user-defined reductions.
+    /// 2. genetic_value_to_fitness(metadata, aggregate) is called for
+    ///    each individual.
+    /// Thus, the cost of a generation is linear in population size.
+    ///
+    /// The single-individual genetic_value_to_fitness uses the aggregate
+    /// from the last call to evaluate_population.
+    {
+        mutable PopulationAggregate aggregate;
+
+        explicit DiploidPopulationGeneticValueWithAggregate(
+            std::size_t dimensionality)
+            : DiploidPopulationGeneticValue(dimensionality), aggregate{}
+        {
+        }
+
+        /// Called prior to the first pass.  Derived classes
+        /// with their own accumulators should reset them here.
+        virtual void
+        begin_aggregation() const
+        {
+        }
+
+        /// Called for each individual during the first pass.
+        virtual void
+        aggregate_individual(const DiploidMetadata& /*metadata*/) const
+        {
+        }
+
+        virtual double
+        genetic_value_to_fitness(const DiploidMetadata& metadata,
+                                 const PopulationAggregate& agg) const = 0;
+
+        double
+        genetic_value_to_fitness(const DiploidMetadata& metadata) const final
+        {
+            return genetic_value_to_fitness(metadata, aggregate);
+        }
+
+        void
+        evaluate_population(const GSLrng_t& rng, const DiploidPopulation& pop,
+                            std::vector<DiploidMetadata>& metadata,
+                            double* genetic_values) const override
+        {
+            aggregate = PopulationAggregate{};
+            begin_aggregation();
+            for (std::size_t i = 0; i < pop.diploids.size(); ++i)
+                {
+                    auto& md = metadata[i];
+                    md.g = calculate_gvalue(i, pop);
+                    md.e = noise(rng, md, md.parents[0], md.parents[1], pop);
+                    aggregate.add(md);
+                    aggregate_individual(md);
+                    if (genetic_values != nullptr)
+                        {
+                            std::copy(begin(gvalues), end(gvalues),
+                                      genetic_values + i * total_dim);
+                        }
+                }
+            for (std::size_t i = 0; i < pop.diploids.size(); ++i)
+                {
+                    metadata[i].w
+                        = genetic_value_to_fitness(metadata[i], aggregate);
+                }
+        }
+    };
+} // namespace fwdpy11
+
+#endif
@@ -27,6 +27,7 @@
 #include <vector>
 #include <queue>
 #include <tuple>
+#include <typeinfo>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <fwdpy11/types/DiploidPopulation.hpp>
@@ -42,6 +43,15 @@ namespace fwdpy11
         virtual void update(const DiploidPopulation & /*pop*/) = 0;
         virtual std::unique_ptr<GeneticValueToFitnessMap> clone() const = 0;
         virtual pybind11::object pickle() const = 0;
+
+        /// Returns true if operator() may be called concurrently
+        /// from several threads.  See
+        /// DiploidPopulationGeneticValue::supports_parallel_evaluation.
+        virtual bool
+        supports_parallel_evaluation() const
+        {
+            return false;
+        }
     };
 
     struct GeneticValueIsFitness : public GeneticValueToFitnessMap
@@ -66,6 +76,13 @@ namespace fwdpy11
         {
             return pybind11::bytes("GeneticValueIsFitness");
         }
+
+        bool
+        supports_parallel_evaluation() const override
+        /// Not inherited, because subclasses may not be thread-safe.
+        {
+            return typeid(*this) == typeid(GeneticValueIsFitness);
+        }
     };
 
     struct GeneticValueIsTrait : public GeneticValueToFitnessMap
@@ -109,6 +126,13 @@ namespace fwdpy11
         {
             return pybind11::make_tuple(opt, VS);
         }
+
+        bool
+        supports_parallel_evaluation() const override
+        /// Not inherited, because subclasses may not be thread-safe.
+        {
+            return typeid(*this) == typeid(GSS);
+        }
     };
 
     struct GSSmo : public GeneticValueIsTrait
@@ -194,6 +218,13 @@ namespace fwdpy11
         {
             return pybind11::make_tuple(opt, VS, current_optimum, optima);
         }
+
+        bool
+        supports_parallel_evaluation() const override
+        /// Not inherited, because subclasses may not be thread-safe.
+        {
+            return typeid(*this) == typeid(GSSmo);
+        }
     };
 } //namespace fwdpy11
 
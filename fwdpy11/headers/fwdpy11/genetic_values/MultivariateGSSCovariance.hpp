@@ -0,0 +1,282 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_MULTIVARIATE_GSS_COVARIANCE_HPP
+#define FWDPY11_MULTIVARIATE_GSS_COVARIANCE_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "MultivariateGeneticValueToFitnessMap.hpp"
+
+namespace fwdpy11
+{
+    struct MultivariateGSSCovariance
+        : public MultivariateGeneticValueToFitnessMap
+    /// Multivariate Gaussian stabilizing selection with an arbitrary
+    /// selection covariance matrix, S:
+    ///
+    /// w = exp(-(z - optimum)^T S^{-1} (z - optimum) / 2).
+    ///
+    /// S = VS * I is the model of MultivariateGSS.
+    ///
+    /// The lower-triangular Cholesky factor, L, of S is obtained once,
+    /// at construction.  The quadratic form is then the squared norm
+    /// of y, where L y = z - optimum, which is solved by forward
+    /// substitution.  The optima may change over time, as for
+    /// MultivariateGSSmo.
+    {
+        std::vector<std::uint32_t> timepoints;
+        /// Row-major, one row per time point
+        std::vector<double> optima;
+        /// Row-major, ndim x ndim
+        std::vector<double> covariance;
+        std::size_t current_timepoint, ndim;
+        /// Row-major Cholesky factor of covariance
+        std::vector<double> cholesky_factor;
+        /// Workspace for evaluate_population, holding the
+        /// solutions for a block of individuals, with trait
+        /// j of individual b at index j * block_size + b.
+        mutable std::vector<double> block;
+        static constexpr std::size_t block_size = 64;
+
+        MultivariateGSSCovariance(std::vector<std::uint32_t> input_timepoints,
+                                  std::vector<double> input_optima,
+                                  std::vector<double> input_covariance)
+            : timepoints(std::move(input_timepoints)),
+              optima(std::move(input_optima)),
+              covariance(std::move(input_covariance)), current_timepoint(1),
+              ndim(0), cholesky_factor{}, block{}
+        {
+            if (timepoints.empty())
+                {
+                    throw std::invalid_argument("empty timepoints");
+                }
+            if (optima.empty())
+                {
+                    throw std::invalid_argument("empty optima");
+                }
+            if (timepoints.front() != 0)
+                {
+                    throw std::invalid_argument(
+                        "first timepoint is not at zero");
+                }
+            if (!std::is_sorted(begin(timepoints), end(timepoints)))
+                {
+                    throw std::invalid_argument("timepoints are not sorted");
+                }
+            if (optima.size() % timepoints.size() != 0)
+                {
+                    throw std::invalid_argument(
+                        "incorrect number of optima or time points");
+                }
+            ndim = optima.size() / timepoints.size();
+            if (covariance.size() != ndim * ndim)
+                {
+                    throw std::invalid_argument(
+                        "covariance matrix dimensions do not match optima");
+                }
+            if (std::any_of(begin(optima), end(optima),
+                            [](double x) { return !std::isfinite(x); }))
+                {
+                    throw std::invalid_argument("optima must be finite");
+                }
+            cholesky_factor = cholesky(covariance, ndim);
+            block.resize(ndim * block_size);
+        }
+
+        static std::vector<double>
+        cholesky(const std::vector<double> &S, const std::size_t n)
+        /// Returns the lower-triangular L such that S = L L^T
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                {
+                    for (std::size_t j = 0; j < i; ++j)
+                        {
+                            if (S[i * n + j] != S[j * n + i])
+                                {
+                                    throw std::invalid_argument(
+                                        "covariance matrix is not "
+                                        "symmetric");
+                                }
+                        }
+                }
+            std::vector<double> L(n * n, 0.0);
+            for (std::size_t j = 0; j < n; ++j)
+                {
+                    double d = S[j * n + j];
+                    for (std::size_t k = 0; k < j; ++k)
+                        {
+                            d -= L[j * n + k] * L[j * n + k];
+                        }
+                    if (!(d > 0.0) || !std::isfinite(d))
+                        {
+                            throw std::invalid_argument(
+                                "covariance matrix is not positive "
+                                "definite");
+                        }
+                    L[j * n + j] = std::sqrt(d);
+                    for (std::size_t i = j + 1; i < n; ++i)
+                        {
+                            double x = S[i * n + j];
+                            for (std::size_t k = 0; k < j; ++k)
+                                {
+                                    x -= L[i * n + k] * L[j * n + k];
+                                }
+                            L[i * n + j] = x / L[j * n + j];
+                        }
+                }
+            return L;
+        }
+
+        inline const double *
+        current_optimum() const
+        {
+            return optima.data() + (current_timepoint - 1) * ndim;
+        }
+
+        void
+        solve_block(const double *values, const std::size_t nb,
+                    double *fitness) const
+        /// Fitness of nb <= block_size individuals, with the
+        /// row-major trait values in values.  The inner loops
+        /// are over individuals, which are contiguous in block.
+        {
+            const auto opt = current_optimum();
+            for (std::size_t j = 0; j < ndim; ++j)
+                {
+                    auto yj = block.data() + j * block_size;
+                    for (std::size_t b = 0; b < nb; ++b)
+                        {
+                            yj[b] = values[b * ndim + j] - opt[j];
+                        }
+                    for (std::size_t k = 0; k < j; ++k)
+                        {
+                            const double l = cholesky_factor[j * ndim + k];
+                            const auto yk = block.data() + k * block_size;
+                            for (std::size_t b = 0; b < nb; ++b)
+                                {
+                                    yj[b] -= l * yk[b];
+                                }
+                        }
+                    const double ljj = cholesky_factor[j * ndim + j];
+                    for (std::size_t b = 0; b < nb; ++b)
+                        {
+                            yj[b] /= ljj;
+                        }
+                }
+            for (std::size_t b = 0; b < nb; ++b)
+                {
+                    fitness[b] = 0.0;
+                }
+            for (std::size_t j = 0; j < ndim; ++j)
+                {
+                    const auto yj = block.data() + j * block_size;
+                    for (std::size_t b = 0; b < nb; ++b)
+                        {
+                            fitness[b] += yj[b] * yj[b];
+                        }
+                }
+            for (std::size_t b = 0; b < nb; ++b)
+                {
+                    fitness[b] = std::exp(-fitness[b] / 2.0);
+                }
+        }
+
+        virtual double
+        operator()(const DiploidMetadata & /*metadata*/,
+                   const std::vector<double> &values) const
+        {
+            if (values.size() != ndim)
+                {
+                    throw std::runtime_error("dimension mismatch");
+                }
+            double w;
+            solve_block(values.data(), 1, &w);
+            return w;
+        }
+
+        void
+        evaluate_population(std::vector<DiploidMetadata> &metadata,
+                            const double *values, const std::size_t n,
+                            const std::size_t values_ndim) const override
+        {
+            if (values_ndim != ndim)
+                {
+                    throw std::runtime_error("dimension mismatch");
+                }
+            double fitness[block_size];
+            for (std::size_t first = 0; first < n; first += block_size)
+                {
+                    const auto nb = std::min(block_size, n - first);
+                    solve_block(values + first * ndim, nb, fitness);
+                    for (std::size_t b = 0; b < nb; ++b)
+                        {
+                            metadata[first + b].w = fitness[b];
+                        }
+                }
+        }
+
+        std::unique_ptr<MultivariateGeneticValueToFitnessMap>
+        clone() const
+        {
+            return std::unique_ptr<MultivariateGSSCovariance>(
+                new MultivariateGSSCovariance(*this));
+        }
+
+        pybind11::object
+        pickle() const
+        {
+            pybind11::list tp, o, c;
+            for (auto x : timepoints)
+                {
+                    tp.append(x);
+                }
+            for (auto x : optima)
+                {
+                    o.append(x);
+                }
+            for (auto x : covariance)
+                {
+                    c.append(x);
+                }
+            return pybind11::make_tuple(tp, o, c);
+        }
+
+        template <typename poptype>
+        inline void
+        update_details(const poptype &pop)
+        {
+            while (current_timepoint < timepoints.size()
+                   && pop.generation >= timepoints[current_timepoint])
+                {
+                    ++current_timepoint;
+                }
+        }
+
+        inline void
+        update(const DiploidPopulation &pop)
+        {
+            update_details(pop);
+        }
+    };
+} // namespace fwdpy11
+
+#endif
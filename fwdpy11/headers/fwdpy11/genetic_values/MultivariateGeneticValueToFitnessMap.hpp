@@ -38,6 +38,25 @@ namespace fwdpy11
         virtual double
         operator()(const DiploidMetadata& /*metadata*/,
                    const std::vector<double>& /*values*/) const = 0;
+
+        /// Batch API: sets metadata[i].w for 0 <= i < n, where the
+        /// ndim trait values of individual i are values[i * ndim]
+        /// to values[i * ndim + ndim - 1].
+        /// The default calls operator() for each individual.
+        virtual void
+        evaluate_population(std::vector<DiploidMetadata>& metadata,
+                            const double* values, const std::size_t n,
+                            const std::size_t ndim) const
+        {
+            std::vector<double> row(ndim);
+            for (std::size_t i = 0; i < n; ++i)
+                {
+                    std::copy(values + i * ndim, values + (i + 1) * ndim,
+                              begin(row));
+                    metadata[i].w = this->operator()(metadata[i], row);
+                }
+        }
+
         virtual void update(const DiploidPopulation& /*pop*/) = 0;
         virtual std::unique_ptr<MultivariateGeneticValueToFitnessMap>
         clone() const = 0;
@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_GENETIC_VALUES_DETAILS_EFFECT_SIZE_MATRIX_HPP__
+#define FWDPY11_GENETIC_VALUES_DETAILS_EFFECT_SIZE_MATRIX_HPP__
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+namespace fwdpy11
+{
+    struct effect_size_matrix
+    /// Row-major copy of the effect sizes, Mutation::esizes,
+    /// of all mutations, indexed by mutation key.
+    /// Rows are padded so that each one starts on a
+    /// 64-byte boundary, allowing for vectorized loads.
+    ///
+    /// The matrix is a snapshot and must be refilled
+    /// whenever the mutation container changes.
+    {
+        static constexpr std::size_t alignment = 64;
+        static constexpr std::size_t row_block = alignment / sizeof(double);
+
+        std::size_t ndim, stride, offset;
+        std::vector<double> storage;
+        /// 0 for mutations whose esizes do not have ndim elements
+        std::vector<std::uint8_t> valid;
+
+        explicit effect_size_matrix(const std::size_t ndim_)
+            : ndim(ndim_),
+              stride(((ndim_ + row_block - 1) / row_block) * row_block),
+              offset(0), storage{}, valid{}
+        {
+        }
+
+        template <typename mcont_t>
+        void
+        fill(const mcont_t& mutations)
+        {
+            storage.assign(mutations.size() * stride + row_block, 0.0);
+            auto misalignment = reinterpret_cast<std::uintptr_t>(storage.data())
+                                % alignment;
+            offset = misalignment ? (alignment - misalignment) / sizeof(double)
+                                  : 0;
+            valid.resize(mutations.size());
+            for (std::size_t key = 0; key < mutations.size(); ++key)
+                {
+                    const auto& esizes = mutations[key].esizes;
+                    valid[key] = (esizes.size() == ndim);
+                    if (valid[key])
+                        {
+                            std::copy(begin(esizes), end(esizes),
+                                      storage.begin() + offset + key * stride);
+                        }
+                }
+        }
+
+        void
+        clear()
+        {
+            storage.clear();
+            storage.shrink_to_fit();
+            valid.clear();
+        }
+
+        inline std::size_t
+        nrows() const
+        {
+            return valid.size();
+        }
+
+        inline const double*
+        row(const std::size_t key) const
+        {
+            return storage.data() + offset + key * stride;
+        }
+    };
+
+    inline void
+    accumulate_effect_sizes(const double* row, const std::size_t ndim,
+                            double* output)
+    /// output[i] += row[i] for i in [0, ndim).  A plain loop
+    /// over contiguous data, which compilers vectorize.
+    {
+        for (std::size_t i = 0; i < ndim; ++i)
+            {
+                output[i] += row[i];
+            }
+    }
+} // namespace fwdpy11
+
+#endif
@@ -0,0 +1,125 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_GENETIC_VALUES_DETAILS_HAPLOID_EFFECTS_HPP__
+#define FWDPY11_GENETIC_VALUES_DETAILS_HAPLOID_EFFECTS_HPP__
+
+#include <cmath>
+#include <fwdpp/fitness_models.hpp>
+#include "GBR.hpp"
+#include "haploid_effects_cache.hpp"
+
+namespace fwdpy11
+{
+    template <typename fwdppT> struct haploid_effects
+    /// Describes how to obtain the genetic value of a diploid
+    /// from haploid_effects_summary objects of its two gametes.
+    /// Specializations define summarize and combine. The latter
+    /// returns false if the diploid's value cannot be obtained
+    /// from the two summaries, in which case it must be
+    /// calculated from the mutations themselves.
+    ///
+    /// fwdpp::multiplicative_diploid is not cacheable, because
+    /// 1 + scaling*s differs from (1 + h*s)^2 for any useful
+    /// dominance, so that only diploids with an empty gamete
+    /// could be combined.
+    {
+        static constexpr bool cacheable = false;
+    };
+
+    template <> struct haploid_effects<fwdpp::additive_diploid>
+    {
+        static constexpr bool cacheable = true;
+
+        template <typename key_container, typename mcont_t>
+        static inline haploid_effects_summary
+        summarize(const fwdpp::additive_diploid& gv, const key_container& keys,
+                  const mcont_t& mutations)
+        {
+            haploid_effects_summary rv;
+            for (auto k : keys)
+                {
+                    const auto& m = mutations[k];
+                    rv.het += m.h * m.s;
+                    rv.hom += gv.scaling * m.s;
+                    rv.codominant
+                        = rv.codominant && (2.0 * m.h == gv.scaling);
+                }
+            rv.empty = keys.empty();
+            rv.computed = true;
+            return rv;
+        }
+
+        static inline bool
+        combine(const fwdpp::additive_diploid& gv,
+                const haploid_effects_summary& a,
+                const haploid_effects_summary& b, const bool same_gamete,
+                double& gvalue)
+        {
+            double sum;
+            if (same_gamete)
+                {
+                    sum = a.hom;
+                }
+            else if (a.empty || b.empty)
+                {
+                    sum = a.het + b.het;
+                }
+            else if (a.codominant && b.codominant)
+                {
+                    // Mutations present in both gametes contribute
+                    // h*s + h*s, which equals scaling*s
+                    sum = a.het + b.het;
+                }
+            else
+                {
+                    return false;
+                }
+            gvalue = gv.make_return_value(sum);
+            return true;
+        }
+    };
+
+    template <> struct haploid_effects<GBR>
+    {
+        static constexpr bool cacheable = true;
+
+        template <typename key_container, typename mcont_t>
+        static inline haploid_effects_summary
+        summarize(const GBR& gv, const key_container& keys,
+                  const mcont_t& mutations)
+        {
+            haploid_effects_summary rv;
+            rv.het = gv.sum_haplotype_effect_sizes(keys, mutations);
+            rv.empty = keys.empty();
+            rv.computed = true;
+            return rv;
+        }
+
+        static inline bool
+        combine(const GBR& /*gv*/, const haploid_effects_summary& a,
+                const haploid_effects_summary& b, const bool /*same_gamete*/,
+                double& gvalue)
+        {
+            gvalue = std::sqrt(a.het * b.het);
+            return true;
+        }
+    };
+} // namespace fwdpy11
+
+#endif
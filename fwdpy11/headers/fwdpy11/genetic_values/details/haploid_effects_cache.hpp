@@ -0,0 +1,145 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_GENETIC_VALUES_DETAILS_HAPLOID_EFFECTS_CACHE_HPP__
+#define FWDPY11_GENETIC_VALUES_DETAILS_HAPLOID_EFFECTS_CACHE_HPP__
+
+#include <cstddef>
+#include <vector>
+#include <fwdpp/forward_types.hpp>
+
+namespace fwdpy11
+{
+    struct haploid_effects_summary
+    /// The contribution of a single gamete to a diploid's
+    /// genetic value, for use by haploid_effects.
+    {
+        /// Sum of effects of the gamete's
+        /// mutations when heterozygous
+        double het;
+        /// Sum of effects of the gamete's
+        /// mutations when homozygous
+        double hom;
+        /// True if the gamete has no selected mutations
+        bool empty;
+        /// True if hom == 2 * het holds for each mutation
+        bool codominant;
+        /// False until the other members are filled
+        bool computed;
+
+        haploid_effects_summary()
+            : het(0.0), hom(0.0), empty(true), codominant(true),
+              computed(false)
+        {
+        }
+    };
+
+    struct haploid_effects_cache
+    /// haploid_effects_summary objects indexed by gamete.
+    ///
+    /// Summaries are computed on demand.  When valid is false,
+    /// the cache is emptied before each evaluation of a population.
+    /// When valid is true, an evolve function is keeping it in sync
+    /// with the gametes: the summary of a gamete is discarded when
+    /// mutate_recombine stores new contents in it (see new_gamete), when
+    /// fixations are removed from it (see validate), and all of them
+    /// are discarded when gametes are compacted or effect sizes change
+    /// (see rebuild).
+    {
+        std::vector<haploid_effects_summary> summaries;
+        /// Number of selected mutations of each gamete when
+        /// its summary was computed
+        std::vector<std::size_t> nkeys;
+        bool valid;
+
+        haploid_effects_cache() : summaries{}, nkeys{}, valid(false) {}
+
+        void
+        reset(std::size_t ngametes)
+        /// Discards all summaries
+        {
+            summaries.assign(ngametes, haploid_effects_summary());
+            nkeys.assign(ngametes, 0);
+        }
+
+        template <typename gcont_t>
+        void
+        rebuild(const gcont_t& gametes)
+        {
+            reset(gametes.size());
+            valid = true;
+        }
+
+        template <typename gcont_t>
+        void
+        validate(const gcont_t& gametes)
+        /// Discards the summaries of gametes whose number of
+        /// selected mutations has changed, which happens when
+        /// fixations are removed.
+        {
+            for (std::size_t g = 0; g < summaries.size() && g < gametes.size();
+                 ++g)
+                {
+                    if (summaries[g].computed
+                        && nkeys[g] != gametes[g].smutations.size())
+                        {
+                            summaries[g] = haploid_effects_summary();
+                        }
+                }
+        }
+
+        void
+        invalidate()
+        {
+            valid = false;
+        }
+
+        template <typename key_container, typename summarize_function>
+        inline const haploid_effects_summary&
+        get(std::size_t g, const key_container& keys,
+            const summarize_function& summarize)
+        /// Returns the summary of gamete g, whose selected
+        /// mutations are keys, calling summarize() if needed.
+        {
+            if (g >= summaries.size())
+                {
+                    summaries.resize(g + 1);
+                    nkeys.resize(g + 1);
+                }
+            auto& h = summaries[g];
+            if (!h.computed)
+                {
+                    h = summarize();
+                    nkeys[g] = keys.size();
+                }
+            return h;
+        }
+
+        void
+        new_gamete(std::size_t g)
+        /// Called by mutate_recombine when gamete g has new contents
+        {
+            if (g < summaries.size())
+                {
+                    summaries[g] = haploid_effects_summary();
+                }
+        }
+    };
+} // namespace fwdpy11
+
+#endif
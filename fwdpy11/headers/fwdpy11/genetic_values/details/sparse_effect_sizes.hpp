@@ -0,0 +1,217 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_GENETIC_VALUES_DETAILS_SPARSE_EFFECT_SIZES_HPP__
+#define FWDPY11_GENETIC_VALUES_DETAILS_SPARSE_EFFECT_SIZES_HPP__
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <fwdpp/forward_types.hpp>
+
+namespace fwdpy11
+{
+    struct sparse_effect_sizes
+    /// Copy of the non-zero effect sizes, Mutation::esizes,
+    /// of all mutations, indexed by mutation key.
+    /// The entries for key are (traits[j], values[j]) for
+    /// first[key] <= j < last[key].
+    ///
+    /// When mutations affect few traits, this uses much less
+    /// memory than effect_size_matrix and adding a mutation's
+    /// effects only touches the traits that it affects.
+    ///
+    /// The data are a snapshot of the mutation container.
+    /// update brings it up to date when mutations have been
+    /// added or keys have been recycled, by appending the entries
+    /// of those keys.  The entries that they replace are only
+    /// removed when they make up half of the storage, at which
+    /// point the snapshot is filled again.  Changes to the effect
+    /// sizes of existing mutations are not detected, so fill must
+    /// be called after them.
+    {
+        std::size_t ndim;
+        std::vector<std::size_t> first, last;
+        std::vector<std::uint32_t> traits;
+        std::vector<double> values;
+        /// 0 for mutations whose esizes do not have ndim elements
+        std::vector<std::uint8_t> valid;
+        /// Position and origin time of the mutation that each
+        /// key referred to when its entries were stored.
+        /// Used by update to detect recycled keys.
+        std::vector<double> positions;
+        std::vector<fwdpp::uint_t> origins;
+        /// Number of entries in use
+        std::size_t nonzero;
+
+        explicit sparse_effect_sizes(const std::size_t ndim_)
+            : ndim(ndim_), first{}, last{}, traits{}, values{}, valid{},
+              positions{}, origins{}, nonzero(0)
+        {
+        }
+
+        template <typename mcont_t>
+        static std::size_t
+        count_nonzero(const mcont_t& mutations, const std::size_t ndim)
+        /// Number of non-zero effect sizes of mutations whose esizes
+        /// have ndim elements.  Used to choose a storage layout
+        /// without filling one.
+        {
+            std::size_t n = 0;
+            for (const auto& m : mutations)
+                {
+                    if (m.esizes.size() == ndim)
+                        {
+                            n += ndim
+                                 - static_cast<std::size_t>(std::count(
+                                     begin(m.esizes), end(m.esizes), 0.0));
+                        }
+                }
+            return n;
+        }
+
+        template <typename mutation_t>
+        void
+        store(const std::size_t key, const mutation_t& mutation)
+        /// Appends the entries of mutation, which is
+        /// referred to by key.
+        {
+            const auto& esizes = mutation.esizes;
+            positions[key] = mutation.pos;
+            origins[key] = mutation.g;
+            valid[key] = (esizes.size() == ndim);
+            first[key] = values.size();
+            if (valid[key])
+                {
+                    for (std::size_t i = 0; i < ndim; ++i)
+                        {
+                            if (esizes[i] != 0.0)
+                                {
+                                    traits.push_back(
+                                        static_cast<std::uint32_t>(i));
+                                    values.push_back(esizes[i]);
+                                }
+                        }
+                }
+            last[key] = values.size();
+            nonzero += last[key] - first[key];
+        }
+
+        void
+        resize(const std::size_t nrows)
+        {
+            first.resize(nrows, 0);
+            last.resize(nrows, 0);
+            valid.resize(nrows, 0);
+            positions.resize(nrows);
+            origins.resize(nrows);
+        }
+
+        template <typename mcont_t>
+        void
+        fill(const mcont_t& mutations)
+        {
+            traits.clear();
+            values.clear();
+            nonzero = 0;
+            resize(mutations.size());
+            for (std::size_t key = 0; key < mutations.size(); ++key)
+                {
+                    store(key, mutations[key]);
+                }
+        }
+
+        template <typename mcont_t>
+        void
+        update(const mcont_t& mutations)
+        /// Stores the entries of new mutations and of recycled keys.
+        {
+            if (mutations.size() < nrows())
+                {
+                    fill(mutations);
+                    return;
+                }
+            const auto old_nrows = nrows();
+            resize(mutations.size());
+            for (std::size_t key = 0; key < mutations.size(); ++key)
+                {
+                    const auto& m = mutations[key];
+                    if (key >= old_nrows || m.pos != positions[key]
+                        || m.g != origins[key])
+                        {
+                            nonzero -= last[key] - first[key];
+                            store(key, m);
+                        }
+                }
+            if (2 * nonzero < values.size())
+                {
+                    fill(mutations);
+                }
+        }
+
+        void
+        clear()
+        {
+            first.clear();
+            last.clear();
+            traits.clear();
+            values.clear();
+            valid.clear();
+            positions.clear();
+            origins.clear();
+            nonzero = 0;
+        }
+
+        inline std::size_t
+        nrows() const
+        {
+            return valid.size();
+        }
+
+        static inline double
+        density(const std::size_t nonzero, const std::size_t nrows,
+                const std::size_t ndim)
+        /// Fraction of the nrows x ndim effect sizes that are non-zero
+        {
+            if (nrows == 0 || ndim == 0)
+                {
+                    return 0.0;
+                }
+            return static_cast<double>(nonzero)
+                   / (static_cast<double>(nrows) * static_cast<double>(ndim));
+        }
+
+        inline double
+        density() const
+        {
+            return density(nonzero, nrows(), ndim);
+        }
+
+        inline void
+        accumulate(const std::size_t key, double* output) const
+        /// output[t] += e for each non-zero (t, e) of key
+        {
+            for (auto j = first[key]; j < last[key]; ++j)
+                {
+                    output[traits[j]] += values[j];
+                }
+        }
+    };
+} // namespace fwdpy11
+
+#endif
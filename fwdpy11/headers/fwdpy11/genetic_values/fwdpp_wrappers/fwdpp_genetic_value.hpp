@@ -1,10 +1,14 @@
 #ifndef FWDPY11_GENETIC_VALUES_WRAPPERS_FWDPP__GVALUE_HPP__
 #define FWDPY11_GENETIC_VALUES_WRAPPERS_FWDPP__GVALUE_HPP__
 
+#include <vector>
+#include <typeinfo>
 #include <type_traits>
 #include <functional>
 #include "../DiploidPopulationGeneticValueWithMapping.hpp"
+#include "../GeneticValueToFitness.hpp"
 #include "../noise.hpp"
+#include "../details/haploid_effects.hpp"
 
 namespace fwdpy11
 {
@@ -16,6 +20,18 @@ namespace fwdpy11
             = std::unique_ptr<fwdpy11::GeneticValueToFitnessMap>;
         const fwdppT gv;
         const pickleFunction pickle_fxn;
+        /// If true, evaluate_population computes the contribution
+        /// of each gamete once, and combines these to obtain genetic
+        /// values whenever possible.  See haploid_effects.
+        bool cache_haploid_effects;
+        mutable haploid_effects_cache haploid_cache;
+        using evaluation_function = void (fwdpp_genetic_value::*)(
+            const GSLrng_t&, const fwdpy11::DiploidPopulation&,
+            std::vector<DiploidMetadata>&, double*, std::size_t,
+            std::size_t) const;
+        /// Evaluates a range of diploids when the haploid cache
+        /// is not in use.  See select_evaluation.
+        evaluation_function evaluate_fxn;
         static_assert(
             std::is_convertible<pickleFunction, std::function<pybind11::object(
                                                     const fwdppT&)>>::value,
@@ -26,7 +42,8 @@ namespace fwdpy11
         fwdpp_genetic_value(forwarded_fwdppT&& gv_)
             : DiploidPopulationGeneticValueWithMapping{ GeneticValueIsFitness() },
               gv{ std::forward<forwarded_fwdppT>(gv_) },
-              pickle_fxn(pickleFunction{})
+              pickle_fxn(pickleFunction{}), cache_haploid_effects(false),
+              haploid_cache{}, evaluate_fxn(select_evaluation())
         {
         }
 
@@ -35,7 +52,8 @@ namespace fwdpy11
                                    const GeneticValueToFitnessMap& gv2w_)
             : DiploidPopulationGeneticValueWithMapping{ gv2w_ },
               gv{ std::forward<forwarded_fwdppT>(gv_) },
-              pickle_fxn(pickleFunction())
+              pickle_fxn(pickleFunction()), cache_haploid_effects(false),
+              haploid_cache{}, evaluate_fxn(select_evaluation())
         {
         }
 
@@ -47,8 +65,8 @@ namespace fwdpy11
               gv{ std::forward<forwarded_fwdppT>(gv_)
 
               },
-              pickle_fxn(pickleFunction())
-
+              pickle_fxn(pickleFunction()), cache_haploid_effects(false),
+              haploid_cache{}, evaluate_fxn(select_evaluation())
         {
         }
 
@@ -61,6 +79,222 @@ namespace fwdpy11
             return gvalues[0];
         }
 
+        void
+        evaluate_population(const GSLrng_t& rng,
+                            const fwdpy11::DiploidPopulation& pop,
+                            std::vector<DiploidMetadata>& metadata,
+                            double* genetic_values) const override
+        /// Genetic values are calculated for all diploids
+        /// by non-virtual calls to gv.  Then, the noise
+        /// is generated for the whole population by one call
+        /// to GeneticValueNoise::generate, and fitness is
+        /// obtained in a final pass.  For the most common
+        /// models, these passes are fused.  See select_evaluation.
+        {
+            const auto N = pop.diploids.size();
+            if (cache_haploid_effects)
+                {
+                    calculate_gvalues_cached(
+                        pop, metadata,
+                        std::integral_constant<
+                            bool, haploid_effects<fwdppT>::cacheable>());
+                    noise_fxn->generate(rng, metadata, 0, N, pop);
+                    apply_fitness_map(metadata, genetic_values, 0, N);
+                }
+            else
+                {
+                    (this->*evaluate_fxn)(rng, pop, metadata, genetic_values,
+                                          0, N);
+                }
+            if (N)
+                {
+                    gvalues[0] = metadata[N - 1].g;
+                }
+        }
+
+        bool
+        supports_parallel_evaluation() const override
+        /// The haploid cache is shared state, so parallel
+        /// evaluation is only possible when it is not in use.
+        /// evaluate_range calls gv2w and noise_fxn, so both must
+        /// support concurrent calls, too.  Subclasses may not be
+        /// thread-safe, so only the exact type qualifies.
+        {
+            return typeid(*this) == typeid(fwdpp_genetic_value)
+                   && !cache_haploid_effects
+                   && gv2w->supports_parallel_evaluation()
+                   && noise_fxn->supports_parallel_evaluation();
+        }
+
+        haploid_effects_cache*
+        tracked_haploid_cache() override
+        {
+            if (cache_haploid_effects && haploid_effects<fwdppT>::cacheable)
+                {
+                    return &haploid_cache;
+                }
+            return nullptr;
+        }
+
+        void
+        evaluate_range(const GSLrng_t& rng,
+                       const fwdpy11::DiploidPopulation& pop,
+                       std::vector<DiploidMetadata>& metadata,
+                       double* genetic_values, std::size_t first,
+                       std::size_t last) const override
+        {
+            (this->*evaluate_fxn)(rng, pop, metadata, genetic_values,
+                                  first, last);
+        }
+
+        void
+        evaluate_generic(const GSLrng_t& rng,
+                         const fwdpy11::DiploidPopulation& pop,
+                         std::vector<DiploidMetadata>& metadata,
+                         double* genetic_values, std::size_t first,
+                         std::size_t last) const
+        {
+            for (std::size_t i = first; i < last; ++i)
+                {
+                    metadata[i].g
+                        = gv(pop.diploids[i], pop.gametes, pop.mutations);
+                }
+            noise_fxn->generate(rng, metadata, first, last, pop);
+            apply_fitness_map(metadata, genetic_values, first, last);
+        }
+
+        template <typename gv2w_t, typename noise_t>
+        void
+        evaluate_fused(const GSLrng_t& rng,
+                       const fwdpy11::DiploidPopulation& pop,
+                       std::vector<DiploidMetadata>& metadata,
+                       double* genetic_values, std::size_t first,
+                       std::size_t last) const
+        /// The dynamic types of gv2w and noise_fxn are gv2w_t
+        /// and noise_t, respectively.  The qualified calls are
+        /// not virtual, allowing the loop body to be inlined.
+        /// Random numbers are consumed in the same order as
+        /// by evaluate_generic.
+        {
+            const auto& map = static_cast<const gv2w_t&>(*gv2w);
+            const auto& noise = static_cast<const noise_t&>(*noise_fxn);
+            for (std::size_t i = first; i < last; ++i)
+                {
+                    auto& md = metadata[i];
+                    md.g = gv(pop.diploids[i], pop.gametes, pop.mutations);
+                    md.e = noise.noise_t::operator()(rng, md, md.parents[0],
+                                                     md.parents[1], pop);
+                    md.w = map.gv2w_t::operator()(md);
+                    if (genetic_values != nullptr)
+                        {
+                            genetic_values[i] = md.g;
+                        }
+                }
+        }
+
+        template <typename noise_t>
+        evaluation_function
+        select_fused_evaluation() const
+        {
+            const auto& type = typeid(*gv2w);
+            if (type == typeid(GeneticValueIsFitness))
+                {
+                    return &fwdpp_genetic_value::evaluate_fused<
+                        GeneticValueIsFitness, noise_t>;
+                }
+            if (type == typeid(GSS))
+                {
+                    return &fwdpp_genetic_value::evaluate_fused<GSS, noise_t>;
+                }
+            if (type == typeid(GSSmo))
+                {
+                    return &fwdpp_genetic_value::evaluate_fused<GSSmo,
+                                                                noise_t>;
+                }
+            return &fwdpp_genetic_value::evaluate_generic;
+        }
+
+        evaluation_function
+        select_evaluation() const
+        /// Chooses a statically composed evaluation for the
+        /// built-in fitness maps and noise classes, and
+        /// evaluate_generic otherwise.  Exact types are compared,
+        /// so that classes derived from the built-in types are
+        /// evaluated via their own virtual functions.
+        {
+            const auto& type = typeid(*noise_fxn);
+            if (type == typeid(NoNoise))
+                {
+                    return select_fused_evaluation<NoNoise>();
+                }
+            if (type == typeid(GaussianNoise))
+                {
+                    return select_fused_evaluation<GaussianNoise>();
+                }
+            return &fwdpp_genetic_value::evaluate_generic;
+        }
+
+        void
+        apply_fitness_map(std::vector<DiploidMetadata>& metadata,
+                          double* genetic_values, std::size_t first,
+                          std::size_t last) const
+        {
+            for (std::size_t i = first; i < last; ++i)
+                {
+                    auto& md = metadata[i];
+                    md.w = gv2w->operator()(md);
+                    if (genetic_values != nullptr)
+                        {
+                            genetic_values[i] = md.g;
+                        }
+                }
+        }
+
+        void
+        calculate_gvalues_cached(const fwdpy11::DiploidPopulation& pop,
+                                 std::vector<DiploidMetadata>& metadata,
+                                 std::true_type) const
+        /// Unless an evolve function keeps the cache valid,
+        /// it is only used during a single call, as gametes
+        /// may be modified from generation to generation.
+        {
+            if (!haploid_cache.valid)
+                {
+                    haploid_cache.reset(pop.gametes.size());
+                }
+            const auto summarize = [this, &pop](const std::size_t g)
+                -> const haploid_effects_summary& {
+                const auto& keys = pop.gametes[g].smutations;
+                return haploid_cache.get(g, keys, [this, &pop, &keys]() {
+                    return haploid_effects<fwdppT>::summarize(gv, keys,
+                                                              pop.mutations);
+                });
+            };
+            for (std::size_t i = 0; i < pop.diploids.size(); ++i)
+                {
+                    const auto& dip = pop.diploids[i];
+                    if (!haploid_effects<fwdppT>::combine(
+                            gv, summarize(dip.first), summarize(dip.second),
+                            dip.first == dip.second, metadata[i].g))
+                        {
+                            metadata[i].g
+                                = gv(dip, pop.gametes, pop.mutations);
+                        }
+                }
+        }
+
+        void
+        calculate_gvalues_cached(const fwdpy11::DiploidPopulation& pop,
+                                 std::vector<DiploidMetadata>& metadata,
+                                 std::false_type) const
+        {
+            for (std::size_t i = 0; i < pop.diploids.size(); ++i)
+                {
+                    metadata[i].g
+                        = gv(pop.diploids[i], pop.gametes, pop.mutations);
+                }
+        }
+
         inline void
         update(const fwdpy11::DiploidPopulation& pop)
         {
@@ -20,6 +20,9 @@
 #define FWDPY11_GENETIC_VALUES_NOISE_HPP__
 
 #include <memory>
+#include <vector>
+#include <typeinfo>
+#include <gsl/gsl_randist.h>
 #include <pybind11/pybind11.h>
 #include <fwdpy11/types/Diploid.hpp>
 #include <fwdpy11/types/DiploidPopulation.hpp>
@@ -38,9 +41,38 @@ namespace fwdpy11
                    const std::size_t /*parent1*/,
                    const std::size_t /*parent2*/,
                    const DiploidPopulation& /*pop*/) const = 0;
+
+        /// Batch API: sets metadata[i].e for first <= i < last,
+        /// in index order.  The genetic values, metadata[i].g,
+        /// must already be set.
+        /// The default calls operator() for each individual.
+        /// Derived classes overriding this function must consume
+        /// random numbers in the same order as operator().
+        virtual void
+        generate(const GSLrng_t& rng, std::vector<DiploidMetadata>& metadata,
+                 std::size_t first, std::size_t last,
+                 const DiploidPopulation& pop) const
+        {
+            for (std::size_t i = first; i < last; ++i)
+                {
+                    auto& md = metadata[i];
+                    md.e = this->operator()(rng, md, md.parents[0],
+                                            md.parents[1], pop);
+                }
+        }
+
         virtual void update(const DiploidPopulation& /*pop*/) = 0;
         virtual std::unique_ptr<GeneticValueNoise> clone() const = 0;
         virtual pybind11::object pickle() const = 0;
+
+        /// Returns true if operator() and generate may be called
+        /// concurrently from several threads, each with its own rng.
+        /// See DiploidPopulationGeneticValue::supports_parallel_evaluation.
+        virtual bool
+        supports_parallel_evaluation() const
+        {
+            return false;
+        }
     };
 
     struct NoNoise : public GeneticValueNoise
@@ -55,6 +87,18 @@ namespace fwdpy11
             return 0.;
         }
 
+        void
+        generate(const GSLrng_t& /*rng*/,
+                 std::vector<DiploidMetadata>& metadata, std::size_t first,
+                 std::size_t last,
+                 const DiploidPopulation& /*pop*/) const override
+        {
+            for (std::size_t i = first; i < last; ++i)
+                {
+                    metadata[i].e = 0.;
+                }
+        }
+
         DEFAULT_DIPLOID_POP_UPDATE();
 
         std::unique_ptr<GeneticValueNoise>
@@ -69,6 +113,13 @@ namespace fwdpy11
             return pybind11::bytes("NoNoise");
         }
 
+        bool
+        supports_parallel_evaluation() const override
+        /// Not inherited, because subclasses may not be thread-safe.
+        {
+            return typeid(*this) == typeid(NoNoise);
+        }
+
         static inline const NoNoise
         unpickle(pybind11::object& o)
         {
@@ -80,6 +131,67 @@ namespace fwdpy11
             return NoNoise();
         }
     };
+
+    struct GaussianNoise : public GeneticValueNoise
+    {
+        const double sd, mean;
+        GaussianNoise(const double s, const double m) : sd{ s }, mean{ m } {}
+        virtual double
+        operator()(const GSLrng_t& rng,
+                   const DiploidMetadata& /*offspring_metadata*/,
+                   const std::size_t /*parent1*/, const std::size_t /*parent2*/,
+                   const DiploidPopulation& /*pop*/) const
+        {
+            return mean + gsl_ran_gaussian_ziggurat(rng.get(), sd);
+        }
+
+        void
+        generate(const GSLrng_t& rng,
+                 std::vector<DiploidMetadata>& metadata,
+                 std::size_t first, std::size_t last,
+                 const DiploidPopulation& /*pop*/) const override
+        /// One deviate per individual, without virtual calls,
+        /// so the output is identical to that of operator()
+        {
+            auto r = rng.get();
+            for (std::size_t i = first; i < last; ++i)
+                {
+                    metadata[i].e = mean + gsl_ran_gaussian_ziggurat(r, sd);
+                }
+        }
+
+        DEFAULT_DIPLOID_POP_UPDATE();
+
+        std::unique_ptr<GeneticValueNoise>
+        clone() const
+        {
+            return std::unique_ptr<GaussianNoise>(new GaussianNoise(*this));
+        }
+
+        virtual pybind11::object
+        pickle() const
+        {
+            return pybind11::make_tuple(sd, mean);
+        }
+
+        bool
+        supports_parallel_evaluation() const override
+        /// Not inherited, because subclasses may not be thread-safe.
+        {
+            return typeid(*this) == typeid(GaussianNoise);
+        }
+
+        static inline GaussianNoise
+        unpickle(pybind11::object& o)
+        {
+            pybind11::tuple t(o);
+            if (t.size() != 2)
+                {
+                    throw std::runtime_error("invalid object state");
+                }
+            return GaussianNoise(t[0].cast<double>(), t[1].cast<double>());
+        }
+    };
 } // namespace fwdpy11
 
 #endif
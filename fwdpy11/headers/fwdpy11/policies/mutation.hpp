@@ -27,6 +27,43 @@
 
 namespace fwdpy11
 {
+    struct fixed_position
+    /// A mutation position chosen by the caller.  infsites_Mutation
+    /// uses it as is, even if it is already in the lookup table,
+    /// which allows recurrent mutation at finite sites.
+    {
+        double pos;
+
+        inline double
+        operator()() const
+        {
+            return pos;
+        }
+    };
+
+    namespace detail
+    {
+        template <typename position_function>
+        inline double
+        new_mutation_position(const Population::lookup_table_t &lookup,
+                              const position_function &posmaker)
+        {
+            auto pos = posmaker();
+            while (lookup.find(pos) != lookup.end())
+                {
+                    pos = posmaker();
+                }
+            return pos;
+        }
+
+        inline double
+        new_mutation_position(const Population::lookup_table_t & /*lookup*/,
+                              const fixed_position &position)
+        {
+            return position.pos;
+        }
+    } // namespace detail
+
     template <typename position_function, typename effect_size_function,
               typename dominance_function>
     std::size_t
@@ -68,11 +105,7 @@ namespace fwdpy11
      *
      */
     {
-        auto pos = posmaker();
-        while (lookup.find(pos) != lookup.end())
-            {
-                pos = posmaker();
-            }
+        auto pos = detail::new_mutation_position(lookup, posmaker);
         auto idx = fwdpp::recycle_mutation_helper(recycling_bin, mutations,
                                                   pos, esize_maker(), hmaker(),
                                                   generation, x);
@@ -125,11 +158,7 @@ namespace fwdpy11
      *
      */
     {
-        auto pos = posmaker();
-        while (lookup.find(pos) != lookup.end())
-            {
-                pos = posmaker();
-            }
+        auto pos = detail::new_mutation_position(lookup, posmaker);
         auto idx = fwdpp::recycle_mutation_helper(
             recycling_bin, mutations, pos, fixed_esize_maker(), fixed_hmaker(),
             generation, esizes(), dominance(), x);
@@ -29,12 +29,18 @@ namespace fwdpy11
         operator()(const GSLrng_t& rng,
                    std::vector<double>& breakpoints) const final
         {
-            if (gsl_rng_uniform(rng.get()) <= prob)
+            if (prob > 0.0 && gsl_rng_uniform(rng.get()) <= prob)
                 {
                     breakpoints.push_back(position);
                 }
         }
 
+        bool
+        zero_recombination() const final
+        {
+            return prob == 0.0;
+        }
+
         pybind11::object
         pickle() const final
         {
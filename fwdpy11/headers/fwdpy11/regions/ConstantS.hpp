@@ -4,18 +4,18 @@
 #include <cmath>
 #include <stdexcept>
 #include <fwdpy11/policies/mutation.hpp>
-#include "Sregion.hpp"
+#include "DFESregion.hpp"
 
 namespace fwdpy11
 {
 
-    struct ConstantS : public Sregion
+    struct ConstantS : public DFESregion<ConstantS>
     {
         double esize, dominance;
 
         ConstantS(const Region& r, const double s, const double es,
                   const double h)
-            : Sregion(r, s), esize(es), dominance(h)
+            : DFESregion<ConstantS>(r, s), esize(es), dominance(h)
         {
             if (!std::isfinite(esize))
                 {
@@ -44,16 +44,18 @@ namespace fwdpy11
                 << ", scaling=" << this->scaling << ')';
             return out.str();
         }
+        template <typename position_function>
         std::uint32_t
-        operator()(
+        generate(
             fwdpp::flagged_mutation_queue& recycling_bin,
             std::vector<Mutation>& mutations,
-            std::unordered_multimap<double, std::uint32_t>& lookup_table,
-            const std::uint32_t generation, const GSLrng_t& rng) const
+            mutation_position_index& lookup_table,
+            const std::uint32_t generation,
+            const position_function& position, const GSLrng_t& rng) const
         {
             return infsites_Mutation(
                 recycling_bin, mutations, lookup_table, generation,
-                [this, &rng]() { return region(rng); },
+                position,
                 [this]() { return esize / scaling; },
                 [this]() { return dominance; }, this->label());
         }
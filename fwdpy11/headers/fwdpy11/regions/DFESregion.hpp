@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_REGIONS_DFESREGION_HPP
+#define FWDPY11_REGIONS_DFESREGION_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <fwdpy11/policies/mutation.hpp>
+#include "Sregion.hpp"
+
+namespace fwdpy11
+{
+    template <typename T, typename Base = Sregion>
+    struct DFESregion : public Base
+    /// Base class of the distributions of effect sizes.
+    ///
+    /// T must define
+    ///
+    /// template <typename position_function>
+    /// std::uint32_t generate(recycling_bin, mutations, lookup_table,
+    ///                        generation, position, rng) const
+    ///
+    /// which generates a mutation at position(), and this class
+    /// implements operator() and generate_mutation in terms of it.
+    /// Base is Sregion, or another DFE whose generate is hidden by T's.
+    {
+        template <typename... args>
+        explicit DFESregion(args&&... a) : Base(std::forward<args>(a)...)
+        {
+        }
+
+        std::uint32_t
+        operator()(fwdpp::flagged_mutation_queue& recycling_bin,
+                   std::vector<Mutation>& mutations,
+                   mutation_position_index& lookup_table,
+                   const std::uint32_t generation,
+                   const GSLrng_t& rng) const override
+        {
+            return static_cast<const T*>(this)->generate(
+                recycling_bin, mutations, lookup_table, generation,
+                [this, &rng]() { return this->region(rng); }, rng);
+        }
+
+        std::uint32_t
+        generate_mutation(fwdpp::flagged_mutation_queue& recycling_bin,
+                          std::vector<Mutation>& mutations,
+                          mutation_position_index& lookup_table,
+                          const std::uint32_t generation,
+                          const fixed_position& position,
+                          const GSLrng_t& rng) const override
+        {
+            return static_cast<const T*>(this)->generate(
+                recycling_bin, mutations, lookup_table, generation, position,
+                rng);
+        }
+
+        bool
+        supports_fixed_positions() const override
+        {
+            return true;
+        }
+    };
+} // namespace fwdpy11
+
+#endif
@@ -4,17 +4,17 @@
 #include <cmath>
 #include <stdexcept>
 #include <fwdpy11/policies/mutation.hpp>
-#include "Sregion.hpp"
+#include "DFESregion.hpp"
 
 namespace fwdpy11
 {
 
-    struct ExpS : public Sregion
+    struct ExpS : public DFESregion<ExpS>
     {
         double mean, dominance;
 
         ExpS(const Region& r, double sc, double m, double h)
-            : Sregion(r, sc), mean(m), dominance(h)
+            : DFESregion<ExpS>(r, sc), mean(m), dominance(h)
         {
             if (!std::isfinite(mean))
                 {
@@ -44,16 +44,18 @@ namespace fwdpy11
             return out.str();
         }
 
+        template <typename position_function>
         std::uint32_t
-        operator()(
+        generate(
             fwdpp::flagged_mutation_queue& recycling_bin,
             std::vector<Mutation>& mutations,
-            std::unordered_multimap<double, std::uint32_t>& lookup_table,
-            const std::uint32_t generation, const GSLrng_t& rng) const
+            mutation_position_index& lookup_table,
+            const std::uint32_t generation,
+            const position_function& position, const GSLrng_t& rng) const
         {
             return infsites_Mutation(
                 recycling_bin, mutations, lookup_table, generation,
-                [this, &rng]() { return region(rng); },
+                position,
                 [this, &rng]() {
                     return gsl_ran_exponential(rng.get(), mean) / scaling;
                 },
@@ -0,0 +1,147 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_REGIONS_FINITESITES_HPP
+#define FWDPY11_REGIONS_FINITESITES_HPP
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <fwdpy11/policies/mutation.hpp>
+#include "Sregion.hpp"
+
+namespace fwdpy11
+{
+    struct FiniteSites : public Sregion
+    /// Generates mutations from dfe at the integer
+    /// sites beg, beg + 1, ..., end - 1 of dfe's region.
+    ///
+    /// The occupied sites are tracked by a bitmap in the
+    /// population's mutation_position_index.  If recurrent is false,
+    /// a new mutation is placed at a site chosen uniformly among
+    /// the unoccupied ones, which has the same distribution as
+    /// redrawing until an unoccupied site is found.  If recurrent is
+    /// true, occupied sites may mutate again, giving more than one
+    /// mutation at the same position.
+    {
+        std::unique_ptr<Sregion> dfe;
+        bool recurrent;
+        std::uint64_t first_site, last_site;
+
+        FiniteSites(std::unique_ptr<Sregion> d, const bool r)
+            : Sregion(d->region, 1.0), dfe(std::move(d)), recurrent(r),
+              first_site(0), last_site(0)
+        {
+            if (!dfe->supports_fixed_positions())
+                {
+                    throw std::invalid_argument(
+                        "dfe must be a distribution of effect sizes");
+                }
+            if (beg() < 0.0 || beg() != std::floor(beg())
+                || end() != std::floor(end()))
+                {
+                    throw std::invalid_argument(
+                        "region bounds must be non-negative integers");
+                }
+            // Sites beyond 2^53 are not exactly representable
+            if (end() > 9007199254740992.0)
+                {
+                    throw std::invalid_argument("end is too large");
+                }
+            first_site = static_cast<std::uint64_t>(beg());
+            last_site = static_cast<std::uint64_t>(end());
+        }
+
+        FiniteSites(const FiniteSites& other)
+            : Sregion(other), dfe(other.dfe->clone()),
+              recurrent(other.recurrent), first_site(other.first_site),
+              last_site(other.last_site)
+        {
+        }
+
+        std::unique_ptr<Sregion>
+        clone() const
+        {
+            return std::unique_ptr<FiniteSites>(new FiniteSites(*this));
+        }
+
+        std::string
+        repr() const
+        {
+            std::ostringstream out;
+            out << "FiniteSites(" << dfe->repr()
+                << ", recurrent=" << (recurrent ? "True" : "False") << ')';
+            return out.str();
+        }
+
+        std::uint32_t
+        operator()(fwdpp::flagged_mutation_queue& recycling_bin,
+                   std::vector<Mutation>& mutations,
+                   mutation_position_index& lookup_table,
+                   const std::uint32_t generation, const GSLrng_t& rng) const
+        {
+            lookup_table.index_sites(first_site, last_site);
+            const auto nsites = last_site - first_site;
+            auto site = first_site
+                        + std::min(static_cast<std::uint64_t>(
+                                       gsl_rng_uniform(rng.get()) * nsites),
+                                   nsites - 1);
+            if (!recurrent && lookup_table.site_occupied(site))
+                {
+                    const auto nfree = lookup_table.unoccupied_sites(
+                        first_site, last_site);
+                    if (nfree == 0)
+                        {
+                            throw std::runtime_error(
+                                "all sites in the region are occupied");
+                        }
+                    site = lookup_table.unoccupied_site(
+                        first_site, last_site,
+                        std::min(static_cast<std::uint64_t>(
+                                     gsl_rng_uniform(rng.get()) * nfree),
+                                 nfree - 1));
+                }
+            return dfe->generate_mutation(
+                recycling_bin, mutations, lookup_table, generation,
+                fixed_position{ static_cast<double>(site) }, rng);
+        }
+
+        pybind11::tuple
+        pickle() const
+        {
+            return pybind11::make_tuple(pybind11::cast(dfe->clone()),
+                                        recurrent);
+        }
+
+        static FiniteSites
+        unpickle(pybind11::tuple t)
+        {
+            if (t.size() != 2)
+                {
+                    throw std::runtime_error("invalid tuple size");
+                }
+            return FiniteSites(t[0].cast<const Sregion&>().clone(),
+                               t[1].cast<bool>());
+        }
+    };
+} // namespace fwdpy11
+
+#endif
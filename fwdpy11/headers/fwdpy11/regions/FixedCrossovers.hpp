@@ -44,6 +44,12 @@ namespace fwdpy11
                 }
         }
 
+        bool
+        zero_recombination() const final
+        {
+            return nxovers == 0;
+        }
+
         pybind11::object
         pickle() const final
         {
@@ -12,6 +12,14 @@ namespace fwdpy11
     {
         virtual ~GeneticMapUnit() = default;
         virtual void operator()(const GSLrng_t&, std::vector<double>&) const = 0;
+        /// Returns true if the unit can never generate a breakpoint.
+        /// Such units must not use the random number generator.
+        /// The default is always safe for types that do not know.
+        virtual bool
+        zero_recombination() const
+        {
+            return false;
+        }
         virtual pybind11::object pickle()  const= 0;
         virtual std::unique_ptr<GeneticMapUnit> clone()  const = 0;
     };
@@ -12,11 +12,12 @@
 #include <functional>
 #include <memory>
 #include <fwdpy11/policies/mutation.hpp>
-#include "Sregion.hpp"
+#include "DFESregion.hpp"
 
 namespace fwdpy11
 {
-    struct MultivariateGaussianEffects : public Sregion
+    struct MultivariateGaussianEffects
+        : public DFESregion<MultivariateGaussianEffects>
     {
         using matrix_ptr
             = std::unique_ptr<gsl_matrix, std::function<void(gsl_matrix *)>>;
@@ -36,7 +37,8 @@ namespace fwdpy11
                                     // NOTE: matrix_is_covariance is
                                     // NOT exposed to Python
                                     double h, bool matrix_is_covariance)
-            : Sregion(r, sc), effect_sizes(input_matrix.size1),
+            : DFESregion<MultivariateGaussianEffects>(r, sc),
+              effect_sizes(input_matrix.size1),
               dominance_values(input_matrix.size1, h),
               matrix(gsl_matrix_alloc(input_matrix.size1, input_matrix.size2),
                      [](gsl_matrix *m) { gsl_matrix_free(m); }),
@@ -124,12 +126,14 @@ namespace fwdpy11
             return out.str();
         }
 
-        virtual std::uint32_t
-        operator()(
+        template <typename position_function>
+        std::uint32_t
+        generate(
             fwdpp::flagged_mutation_queue &recycling_bin,
             std::vector<Mutation> &mutations,
-            std::unordered_multimap<double, std::uint32_t> &lookup_table,
-            const std::uint32_t generation, const GSLrng_t &rng) const
+            mutation_position_index &lookup_table,
+            const std::uint32_t generation,
+            const position_function &position, const GSLrng_t &rng) const
         {
             int rv = gsl_ran_multivariate_gaussian(rng.get(), mu.get(),
                                                    matrix.get(), &res.vector);
@@ -140,7 +144,7 @@ namespace fwdpy11
                 }
             return infsites_Mutation(
                 recycling_bin, mutations, lookup_table, generation,
-                [this, &rng]() { return region(rng); },
+                position,
                 [this]() { return fixed_effect; },
                 [this]() { return dominance; },
                 [this]() { return effect_sizes; },
@@ -189,7 +193,7 @@ namespace fwdpy11
         }
     };
 
-    bool
+    inline bool
     operator==(const MultivariateGaussianEffects &lhs,
                const MultivariateGaussianEffects &rhs)
     {
@@ -0,0 +1,392 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_REGIONS_MUTATIONINTERVALMAP_HPP
+#define FWDPY11_REGIONS_MUTATIONINTERVALMAP_HPP
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <gsl/gsl_randist.h>
+#include <fwdpy11/policies/mutation.hpp>
+#include "Sregion.hpp"
+
+namespace fwdpy11
+{
+    namespace detail
+    {
+        struct mutation_intervals
+        /// Validated intervals of a MutationIntervalMap,
+        /// sorted by start position.
+        {
+            std::vector<double> starts, stops, rates;
+            std::vector<std::size_t> classes;
+            /// cumulative[i] is the summed weight
+            /// of the first i intervals
+            std::vector<double> cumulative;
+
+            mutation_intervals(const std::vector<double>& input_starts,
+                               const std::vector<double>& input_stops,
+                               const std::vector<double>& input_rates,
+                               const std::vector<std::size_t>& input_classes,
+                               const std::size_t nclasses)
+                : starts{}, stops{}, rates{}, classes{}, cumulative{}
+            {
+                const auto n = input_starts.size();
+                if (n == 0)
+                    {
+                        throw std::invalid_argument("empty mutation map");
+                    }
+                if (input_stops.size() != n || input_rates.size() != n
+                    || input_classes.size() != n)
+                    {
+                        throw std::invalid_argument(
+                            "starts, stops, rates, and classes must have "
+                            "the same length");
+                    }
+                std::vector<std::size_t> order(n);
+                std::iota(begin(order), end(order), 0);
+                std::stable_sort(begin(order), end(order),
+                                 [&input_starts](std::size_t i,
+                                                 std::size_t j) {
+                                     return input_starts[i]
+                                            < input_starts[j];
+                                 });
+                starts.reserve(n);
+                stops.reserve(n);
+                rates.reserve(n);
+                classes.reserve(n);
+                cumulative.reserve(n + 1);
+                cumulative.push_back(0.0);
+                for (auto i : order)
+                    {
+                        if (!std::isfinite(input_starts[i])
+                            || !std::isfinite(input_stops[i]))
+                            {
+                                throw std::invalid_argument(
+                                    "interval bounds must be finite");
+                            }
+                        if (!(input_stops[i] > input_starts[i]))
+                            {
+                                throw std::invalid_argument(
+                                    "interval stop must be greater than "
+                                    "start");
+                            }
+                        if (!stops.empty() && input_starts[i] < stops.back())
+                            {
+                                throw std::invalid_argument(
+                                    "intervals must not overlap");
+                            }
+                        if (!std::isfinite(input_rates[i])
+                            || input_rates[i] < 0.0)
+                            {
+                                throw std::invalid_argument(
+                                    "rates must be finite and non-negative");
+                            }
+                        if (input_classes[i] >= nclasses)
+                            {
+                                throw std::invalid_argument(
+                                    "DFE class index out of range");
+                            }
+                        starts.push_back(input_starts[i]);
+                        stops.push_back(input_stops[i]);
+                        rates.push_back(input_rates[i]);
+                        classes.push_back(input_classes[i]);
+                        cumulative.push_back(
+                            cumulative.back()
+                            + input_rates[i]
+                                  * (input_stops[i] - input_starts[i]));
+                    }
+                if (!std::isfinite(cumulative.back())
+                    || !(cumulative.back() > 0.0))
+                    {
+                        throw std::invalid_argument(
+                            "total weight of the map must be finite and "
+                            "positive");
+                    }
+            }
+        };
+    } // namespace detail
+
+    struct MutationIntervalMap : public Sregion
+    /// A mutation "region" made up of many non-overlapping
+    /// intervals, each with its own rate and DFE class.
+    ///
+    /// rates[i] is a weight per unit length, so interval i
+    /// receives a fraction rates[i] * (stops[i] - starts[i]) / total()
+    /// of the mutations generated by this object.  Intervals are
+    /// chosen by a binary search of the cumulative weights, and the
+    /// DFE class then generates a mutation uniformly within the interval.
+    /// Thus, the cost per mutation does not depend on the number of
+    /// intervals.
+    ///
+    /// The positions and weights of the DFE classes are ignored.
+    {
+        detail::mutation_intervals intervals;
+        std::vector<std::unique_ptr<Sregion>> dfe;
+
+        MutationIntervalMap(detail::mutation_intervals iv,
+                            std::vector<std::unique_ptr<Sregion>> dfe_classes)
+            : Sregion(Region(iv.starts.front(), iv.stops.back(),
+                             iv.cumulative.back(), false, 0),
+                      1.0),
+              intervals(std::move(iv)), dfe(std::move(dfe_classes))
+        {
+            for (auto& d : dfe)
+                {
+                    if (d == nullptr)
+                        {
+                            throw std::invalid_argument(
+                                "DFE classes must not be None");
+                        }
+                    if (!d->supports_fixed_positions())
+                        {
+                            throw std::invalid_argument(
+                                "DFE classes must be distributions of "
+                                "effect sizes");
+                        }
+                }
+        }
+
+        MutationIntervalMap(const std::vector<double>& starts,
+                            const std::vector<double>& stops,
+                            const std::vector<double>& rates,
+                            const std::vector<std::size_t>& classes,
+                            std::vector<std::unique_ptr<Sregion>> dfe_classes)
+            : MutationIntervalMap(
+                  detail::mutation_intervals(starts, stops, rates, classes,
+                                             dfe_classes.size()),
+                  std::move(dfe_classes))
+        {
+        }
+
+        MutationIntervalMap(const MutationIntervalMap& other)
+            : Sregion(other), intervals(other.intervals), dfe{}
+        {
+            for (auto& d : other.dfe)
+                {
+                    dfe.emplace_back(d->clone());
+                }
+        }
+
+        inline double
+        total() const
+        {
+            return intervals.cumulative.back();
+        }
+
+        inline std::size_t
+        interval(const double x) const
+        /// Returns the interval containing x, for 0 <= x < total(),
+        /// in the cumulative weights.
+        {
+            const auto& c = intervals.cumulative;
+            auto i = static_cast<std::size_t>(
+                         std::upper_bound(begin(c), end(c), x) - begin(c))
+                     - 1;
+            // Intervals of zero weight are only found
+            // when x is at the end of the map.
+            i = std::min(i, intervals.rates.size() - 1);
+            while (i > 0 && intervals.rates[i] == 0.0)
+                {
+                    --i;
+                }
+            return i;
+        }
+
+        std::unique_ptr<Sregion>
+        clone() const
+        {
+            return std::unique_ptr<MutationIntervalMap>(
+                new MutationIntervalMap(*this));
+        }
+
+        std::string
+        repr() const
+        {
+            std::ostringstream out;
+            out.precision(4);
+            out << "MutationIntervalMap(nintervals=" << intervals.starts.size()
+                << ", beg=" << this->beg() << ", end=" << this->end()
+                << ", total=" << total() << ", nclasses=" << dfe.size()
+                << ')';
+            return out.str();
+        }
+
+        std::uint32_t
+        operator()(
+            fwdpp::flagged_mutation_queue& recycling_bin,
+            std::vector<Mutation>& mutations,
+            mutation_position_index& lookup_table,
+            const std::uint32_t generation, const GSLrng_t& rng) const
+        {
+            const auto i = interval(gsl_rng_uniform(rng.get()) * total());
+            const double start = intervals.starts[i],
+                         stop = intervals.stops[i];
+            const auto pos = detail::new_mutation_position(
+                lookup_table, [start, stop, &rng]() {
+                    return gsl_ran_flat(rng.get(), start, stop);
+                });
+            return dfe[intervals.classes[i]]->generate_mutation(
+                recycling_bin, mutations, lookup_table, generation,
+                fixed_position{ pos }, rng);
+        }
+
+        pybind11::tuple
+        pickle() const
+        {
+            pybind11::list s, e, r, c, d;
+            for (std::size_t i = 0; i < intervals.starts.size(); ++i)
+                {
+                    s.append(intervals.starts[i]);
+                    e.append(intervals.stops[i]);
+                    r.append(intervals.rates[i]);
+                    c.append(intervals.classes[i]);
+                }
+            for (auto& x : dfe)
+                {
+                    d.append(pybind11::cast(x->clone()));
+                }
+            return pybind11::make_tuple(s, e, r, c, d);
+        }
+
+        static MutationIntervalMap
+        unpickle(pybind11::tuple t)
+        {
+            if (t.size() != 5)
+                {
+                    throw std::runtime_error("invalid tuple size");
+                }
+            std::vector<double> s, e, r;
+            std::vector<std::size_t> c;
+            std::vector<std::unique_ptr<Sregion>> d;
+            for (auto i : t[0].cast<pybind11::list>())
+                {
+                    s.push_back(i.cast<double>());
+                }
+            for (auto i : t[1].cast<pybind11::list>())
+                {
+                    e.push_back(i.cast<double>());
+                }
+            for (auto i : t[2].cast<pybind11::list>())
+                {
+                    r.push_back(i.cast<double>());
+                }
+            for (auto i : t[3].cast<pybind11::list>())
+                {
+                    c.push_back(i.cast<std::size_t>());
+                }
+            for (auto i : t[4].cast<pybind11::list>())
+                {
+                    d.emplace_back(i.cast<const Sregion&>().clone());
+                }
+            return MutationIntervalMap(s, e, r, c, std::move(d));
+        }
+
+        static MutationIntervalMap
+        from_bed(const std::string& filename,
+                 std::vector<std::unique_ptr<Sregion>> dfe_classes)
+        /// Reads intervals from a BED-like file.  Each line has
+        /// the columns chromosome, start, stop, and optionally
+        /// a rate (default 1) and a DFE class (default 0).
+        /// Further columns are ignored.  Blank lines, comments,
+        /// and "track" and "browser" lines are skipped.
+        /// All intervals must be on the same chromosome.
+        {
+            std::ifstream in(filename);
+            if (!in)
+                {
+                    throw std::invalid_argument("could not open "
+                                                + filename);
+                }
+            std::vector<double> s, e, r;
+            std::vector<std::size_t> c;
+            std::string line, chrom;
+            std::size_t lineno = 0;
+            while (std::getline(in, line))
+                {
+                    ++lineno;
+                    std::istringstream fields(line);
+                    std::vector<std::string> f;
+                    std::string x;
+                    while (fields >> x)
+                        {
+                            f.push_back(x);
+                        }
+                    if (f.empty() || f[0][0] == '#' || f[0] == "track"
+                        || f[0] == "browser")
+                        {
+                            continue;
+                        }
+                    const auto error = [&filename, lineno](const char* what) {
+                        return std::invalid_argument(
+                            "line " + std::to_string(lineno) + " of "
+                            + filename + ": " + what);
+                    };
+                    if (f.size() < 3)
+                        {
+                            throw error("too few columns");
+                        }
+                    if (s.empty())
+                        {
+                            chrom = f[0];
+                        }
+                    else if (f[0] != chrom)
+                        {
+                            throw error("more than one chromosome");
+                        }
+                    const auto parse = [&error](const std::string& field) {
+                        std::size_t n = 0;
+                        double v = 0.0;
+                        try
+                            {
+                                v = std::stod(field, &n);
+                            }
+                        catch (const std::logic_error&)
+                            {
+                                n = 0;
+                            }
+                        if (n == 0 || n != field.size())
+                            {
+                                throw error("could not be parsed");
+                            }
+                        return v;
+                    };
+                    s.push_back(parse(f[1]));
+                    e.push_back(parse(f[2]));
+                    r.push_back(f.size() > 3 ? parse(f[3]) : 1.0);
+                    double k = f.size() > 4 ? parse(f[4]) : 0.0;
+                    if (k < 0.0 || k != std::floor(k))
+                        {
+                            throw error(
+                                "DFE class must be a non-negative integer");
+                        }
+                    c.push_back(static_cast<std::size_t>(k));
+                }
+            return MutationIntervalMap(s, e, r, c, std::move(dfe_classes));
+        }
+    };
+} // namespace fwdpy11
+
+#endif
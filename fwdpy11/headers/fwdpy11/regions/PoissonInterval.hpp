@@ -40,6 +40,10 @@ namespace fwdpy11
         operator()(const GSLrng_t& rng,
                    std::vector<double>& breakpoints) const final
         {
+            if (mean == 0.0)
+                {
+                    return;
+                }
             unsigned n = gsl_ran_poisson(rng.get(), mean);
             for (unsigned i = 0; i < n; ++i)
                 {
@@ -47,6 +51,12 @@ namespace fwdpy11
                 }
         }
 
+        bool
+        zero_recombination() const final
+        {
+            return mean == 0.0;
+        }
+
         pybind11::object
         pickle() const final
         {
@@ -0,0 +1,279 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_REGIONS_RECOMBINATIONRATEMAP_HPP
+#define FWDPY11_REGIONS_RECOMBINATIONRATEMAP_HPP
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <gsl/gsl_randist.h>
+#include "GeneticMapUnit.hpp"
+
+namespace fwdpy11
+{
+    struct RecombinationRateMap : public GeneticMapUnit
+    /// Piecewise-constant recombination rates.
+    /// rates[i] is the expected number of crossovers per unit
+    /// length per gamete in [positions[i], positions[i + 1]).
+    ///
+    /// The number of breakpoints is a single Poisson draw, and each
+    /// breakpoint is placed by a binary search of the cumulative
+    /// map, so the cost per gamete does not depend on the number
+    /// of intervals.
+    {
+        std::vector<double> positions, rates;
+        /// cumulative[i] is the expected number of
+        /// crossovers in [positions[0], positions[i])
+        std::vector<double> cumulative;
+
+        RecombinationRateMap(std::vector<double> input_positions,
+                             std::vector<double> input_rates)
+            : positions(std::move(input_positions)),
+              rates(std::move(input_rates)), cumulative{}
+        {
+            if (rates.empty())
+                {
+                    throw std::invalid_argument("empty recombination map");
+                }
+            if (positions.size() != rates.size() + 1)
+                {
+                    throw std::invalid_argument(
+                        "there must be one more position than rates");
+                }
+            for (auto p : positions)
+                {
+                    if (!std::isfinite(p))
+                        {
+                            throw std::invalid_argument(
+                                "positions must be finite");
+                        }
+                }
+            for (std::size_t i = 1; i < positions.size(); ++i)
+                {
+                    if (!(positions[i] > positions[i - 1]))
+                        {
+                            throw std::invalid_argument(
+                                "positions must be strictly increasing");
+                        }
+                }
+            for (auto r : rates)
+                {
+                    if (!std::isfinite(r) || r < 0.0)
+                        {
+                            throw std::invalid_argument(
+                                "rates must be finite and non-negative");
+                        }
+                }
+            cumulative.resize(positions.size());
+            cumulative[0] = 0.0;
+            for (std::size_t i = 0; i < rates.size(); ++i)
+                {
+                    cumulative[i + 1]
+                        = cumulative[i]
+                          + rates[i] * (positions[i + 1] - positions[i]);
+                }
+            if (!std::isfinite(cumulative.back()))
+                {
+                    throw std::invalid_argument(
+                        "total map length is not finite");
+                }
+        }
+
+        inline double
+        total() const
+        /// Expected number of crossovers per gamete
+        {
+            return cumulative.back();
+        }
+
+        inline double
+        position(const double x) const
+        /// Inverse of the cumulative map, for 0 <= x < total()
+        {
+            auto i = static_cast<std::size_t>(
+                         std::upper_bound(begin(cumulative), end(cumulative),
+                                          x)
+                         - begin(cumulative))
+                     - 1;
+            // Intervals with a rate of zero have no width in
+            // cumulative, so they are only found when x is
+            // at the end of the map.
+            i = std::min(i, rates.size() - 1);
+            while (i > 0 && rates[i] == 0.0)
+                {
+                    --i;
+                }
+            auto p = positions[i] + (x - cumulative[i]) / rates[i];
+            return std::min(p, std::nextafter(positions[i + 1],
+                                              positions[i]));
+        }
+
+        void
+        operator()(const GSLrng_t& rng,
+                   std::vector<double>& breakpoints) const final
+        {
+            const double t = total();
+            if (t == 0.0)
+                {
+                    return;
+                }
+            unsigned n = gsl_ran_poisson(rng.get(), t);
+            for (unsigned i = 0; i < n; ++i)
+                {
+                    breakpoints.push_back(
+                        position(gsl_rng_uniform(rng.get()) * t));
+                }
+        }
+
+        bool
+        zero_recombination() const final
+        {
+            return total() == 0.0;
+        }
+
+        pybind11::object
+        pickle() const final
+        {
+            pybind11::list p, r;
+            for (auto x : positions)
+                {
+                    p.append(x);
+                }
+            for (auto x : rates)
+                {
+                    r.append(x);
+                }
+            return pybind11::make_tuple(p, r);
+        }
+
+        std::unique_ptr<GeneticMapUnit>
+        clone() const final
+        {
+            return std::unique_ptr<GeneticMapUnit>(
+                new RecombinationRateMap(*this));
+        }
+
+        static RecombinationRateMap
+        unpickle(pybind11::object o)
+        {
+            auto t = o.cast<pybind11::tuple>();
+            if (t.size() != 2)
+                {
+                    throw std::runtime_error("invalid tuple size");
+                }
+            std::vector<double> p, r;
+            for (auto i : t[0].cast<pybind11::list>())
+                {
+                    p.push_back(i.cast<double>());
+                }
+            for (auto i : t[1].cast<pybind11::list>())
+                {
+                    r.push_back(i.cast<double>());
+                }
+            return RecombinationRateMap(std::move(p), std::move(r));
+        }
+
+        static RecombinationRateMap
+        from_hapmap(const std::string& filename, const double scaling)
+        /// Reads a HapMap-style map.  Lines have either
+        /// the columns chromosome, position, rate (cM/Mb), map (cM),
+        /// or position, rate, map.  The rate on each line applies
+        /// from its position to the next one.  Rates are converted
+        /// to crossovers per base pair and multiplied by scaling.
+        /// A header line and blank lines are skipped.
+        {
+            if (!std::isfinite(scaling) || scaling < 0.0)
+                {
+                    throw std::invalid_argument(
+                        "scaling must be finite and non-negative");
+                }
+            std::ifstream in(filename);
+            if (!in)
+                {
+                    throw std::invalid_argument("could not open "
+                                                + filename);
+                }
+            std::vector<double> p, r;
+            std::string line;
+            std::size_t lineno = 0;
+            while (std::getline(in, line))
+                {
+                    ++lineno;
+                    std::istringstream fields(line);
+                    std::vector<std::string> f;
+                    std::string x;
+                    while (fields >> x)
+                        {
+                            f.push_back(x);
+                        }
+                    if (f.empty())
+                        {
+                            continue;
+                        }
+                    if (f.size() != 3 && f.size() != 4)
+                        {
+                            throw std::invalid_argument(
+                                "line " + std::to_string(lineno) + " of "
+                                + filename + " has the wrong number of "
+                                + "columns");
+                        }
+                    const std::size_t offset = f.size() - 3;
+                    double pos, rate;
+                    try
+                        {
+                            std::size_t n1, n2;
+                            pos = std::stod(f[offset], &n1);
+                            rate = std::stod(f[offset + 1], &n2);
+                            if (n1 != f[offset].size()
+                                || n2 != f[offset + 1].size())
+                                {
+                                    throw std::invalid_argument("");
+                                }
+                        }
+                    catch (const std::logic_error&)
+                        {
+                            if (p.empty() && lineno == 1)
+                                {
+                                    // header
+                                    continue;
+                                }
+                            throw std::invalid_argument(
+                                "line " + std::to_string(lineno) + " of "
+                                + filename + " could not be parsed");
+                        }
+                    p.push_back(pos);
+                    r.push_back(rate * 1e-8 * scaling);
+                }
+            if (p.size() < 2)
+                {
+                    throw std::invalid_argument(
+                        filename + " contains fewer than two positions");
+                }
+            // The last rate applies beyond the end of the map
+            r.pop_back();
+            return RecombinationRateMap(std::move(p), std::move(r));
+        }
+    };
+} // namespace fwdpy11
+
+#endif
@@ -17,6 +17,15 @@ namespace fwdpy11
     {
         virtual ~GeneticMap() = default;
         virtual std::vector<double> operator()(const GSLrng_t& rng) const = 0;
+        /// Returns true if the map can never generate a crossover.
+        /// Such maps must not use the random number generator,
+        /// so that skipping them does not change a simulation.
+        /// The default is always safe for types that do not know.
+        virtual bool
+        zero_recombination() const
+        {
+            return false;
+        }
     };
 
     struct RecombinationRegions : public GeneticMap
@@ -39,6 +48,10 @@ namespace fwdpy11
         std::vector<double>
         operator()(const GSLrng_t& rng) const final
         {
+            if (zero_recombination())
+                {
+                    return {};
+                }
             unsigned nbreaks = gsl_ran_poisson(rng.get(), recrate);
             if (nbreaks == 0)
                 {
@@ -55,6 +68,12 @@ namespace fwdpy11
             rv.push_back(std::numeric_limits<double>::max());
             return rv;
         }
+
+        bool
+        zero_recombination() const final
+        {
+            return recrate == 0.0 || regions.empty();
+        }
     };
 
     struct GeneralizedGeneticMap : public GeneticMap
@@ -80,6 +99,15 @@ namespace fwdpy11
                 }
             return rv;
         }
+
+        bool
+        zero_recombination() const final
+        {
+            return std::all_of(begin(callbacks), end(callbacks),
+                               [](const std::unique_ptr<GeneticMapUnit>& c) {
+                                   return c->zero_recombination();
+                               });
+        }
     };
 
     struct MlocusRecombinationRegions
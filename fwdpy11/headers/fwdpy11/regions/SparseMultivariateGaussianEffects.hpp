@@ -0,0 +1,189 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_SPARSEMULTIVARIATEGAUSSIAN_HPP
+#define FWDPY11_SPARSEMULTIVARIATEGAUSSIAN_HPP
+
+#include <cstdint>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+#include "MultivariateGaussianEffects.hpp"
+
+namespace fwdpy11
+{
+    struct SparseMultivariateGaussianEffects
+        : public DFESregion<SparseMultivariateGaussianEffects,
+                            MultivariateGaussianEffects>
+    /// Pleiotropic effects on a subset of ndim traits.
+    /// Effects on the traits listed in traits are drawn from
+    /// a multivariate Gaussian, and all other effects are zero.
+    /// The matrix therefore has traits.size() rows rather than
+    /// ndim, so the cost of the Gaussian draw scales with the
+    /// number of traits affected.
+    ///
+    /// Mutation::esizes and Mutation::heffects remain dense.
+    /// Each new mutation copies expanded_effect_sizes and
+    /// expanded_dominance_values, which have ndim elements, so
+    /// creating a mutation is still O(ndim), as is the memory
+    /// used by each mutation.
+    {
+        std::size_t ndim;
+        std::vector<std::size_t> traits;
+        // Holds the effect sizes of the latest mutation,
+        // with zeros for traits that it does not affect.
+        mutable std::vector<double> expanded_effect_sizes;
+        std::vector<double> expanded_dominance_values;
+
+        SparseMultivariateGaussianEffects(MultivariateGaussianEffects &&base,
+                                          const std::size_t ndim_,
+                                          std::vector<std::size_t> traits_)
+            : DFESregion<SparseMultivariateGaussianEffects,
+                         MultivariateGaussianEffects>(std::move(base)),
+              ndim(ndim_), traits(std::move(traits_)),
+              expanded_effect_sizes(ndim_, 0.0),
+              expanded_dominance_values(ndim_, this->dominance)
+        {
+            if (traits.size() != effect_sizes.size())
+                {
+                    throw std::invalid_argument(
+                        "number of traits does not match matrix dimensions");
+                }
+            std::vector<std::uint8_t> seen(ndim, 0);
+            for (auto t : traits)
+                {
+                    if (t >= ndim)
+                        {
+                            throw std::invalid_argument(
+                                "trait index out of range");
+                        }
+                    if (seen[t])
+                        {
+                            throw std::invalid_argument(
+                                "trait indexes must be unique");
+                        }
+                    seen[t] = 1;
+                }
+        }
+
+        virtual std::unique_ptr<Sregion>
+        clone() const
+        {
+            auto base = MultivariateGaussianEffects(
+                fwdpy11::Region(this->beg(), this->end(), this->weight(),
+                                this->region.coupled, this->label()),
+                1.0, *matrix.get(), this->fixed_effect, this->dominance,
+                false);
+            return std::unique_ptr<SparseMultivariateGaussianEffects>(
+                new SparseMultivariateGaussianEffects(std::move(base), ndim,
+                                                      traits));
+        }
+
+        std::string
+        repr() const
+        {
+            std::ostringstream out;
+            out.precision(4);
+            out << "SparseMultivariateGaussianEffects(";
+            this->region.region_repr(out);
+            out << ", ndim=" << ndim << ", traits=[";
+            for (std::size_t i = 0; i < traits.size(); ++i)
+                {
+                    out << traits[i];
+                    if (i + 1 < traits.size())
+                        {
+                            out << ", ";
+                        }
+                }
+            out << "], s=" << this->fixed_effect << ", h=" << this->dominance
+                << ", matrix at " << matrix.get() << ')';
+            return out.str();
+        }
+
+        template <typename position_function>
+        std::uint32_t
+        generate(
+            fwdpp::flagged_mutation_queue &recycling_bin,
+            std::vector<Mutation> &mutations,
+            mutation_position_index &lookup_table,
+            const std::uint32_t generation,
+            const position_function &position, const GSLrng_t &rng) const
+        {
+            int rv = gsl_ran_multivariate_gaussian(rng.get(), mu.get(),
+                                                   matrix.get(), &res.vector);
+            if (rv != GSL_SUCCESS)
+                {
+                    throw std::runtime_error(
+                        "call to gsl_ran_multivariate_gaussian failed");
+                }
+            for (std::size_t i = 0; i < traits.size(); ++i)
+                {
+                    expanded_effect_sizes[traits[i]] = effect_sizes[i];
+                }
+            return infsites_Mutation(
+                recycling_bin, mutations, lookup_table, generation,
+                position,
+                [this]() { return fixed_effect; },
+                [this]() { return dominance; },
+                [this]() { return expanded_effect_sizes; },
+                [this]() { return expanded_dominance_values; },
+                this->label());
+        }
+
+        pybind11::tuple
+        pickle() const
+        {
+            pybind11::list t;
+            for (auto i : traits)
+                {
+                    t.append(i);
+                }
+            return pybind11::make_tuple(MultivariateGaussianEffects::pickle(),
+                                        ndim, t);
+        }
+
+        static SparseMultivariateGaussianEffects
+        unpickle(pybind11::tuple t)
+        {
+            if (t.size() != 3)
+                {
+                    throw std::runtime_error("invalid tuple size");
+                }
+            auto base = MultivariateGaussianEffects::unpickle(
+                t[0].cast<pybind11::tuple>());
+            std::vector<std::size_t> traits;
+            for (auto i : t[2].cast<pybind11::list>())
+                {
+                    traits.push_back(i.cast<std::size_t>());
+                }
+            return SparseMultivariateGaussianEffects(
+                std::move(base), t[1].cast<std::size_t>(), std::move(traits));
+        }
+    };
+
+    inline bool
+    operator==(const SparseMultivariateGaussianEffects &lhs,
+               const SparseMultivariateGaussianEffects &rhs)
+    {
+        return static_cast<const MultivariateGaussianEffects &>(lhs)
+                   == static_cast<const MultivariateGaussianEffects &>(rhs)
+               && lhs.ndim == rhs.ndim && lhs.traits == rhs.traits;
+    }
+} // namespace fwdpy11
+
+#endif
@@ -2,17 +2,21 @@
 #define FWDPY11_SREGION_HPP
 
 #include <memory>
+#include <stdexcept>
 #include <vector>
 #include <cmath>
 #include <unordered_map>
 #include <fwdpp/forward_types.hpp>
 #include <fwdpp/simfunctions/recycling.hpp>
 #include <fwdpy11/types/Mutation.hpp>
+#include <fwdpy11/types/mutation_position_index.hpp>
 #include <fwdpy11/rng.hpp>
 #include "Region.hpp"
 
 namespace fwdpy11
 {
+    struct fixed_position;
+
     struct Sregion
     {
         Region region; // For returning positions
@@ -58,10 +62,35 @@ namespace fwdpy11
         virtual std::uint32_t operator()(
             fwdpp::flagged_mutation_queue& /*recycling_bin*/,
             std::vector<Mutation>& /*mutations*/,
-            std::unordered_multimap<double, std::uint32_t>& /*lookup_table*/,
+            mutation_position_index& /*lookup_table*/,
             const std::uint32_t /*generation*/,
             const GSLrng_t& /*rng*/) const = 0;
 
+        virtual std::uint32_t
+        generate_mutation(
+            fwdpp::flagged_mutation_queue& /*recycling_bin*/,
+            std::vector<Mutation>& /*mutations*/,
+            mutation_position_index& /*lookup_table*/,
+            const std::uint32_t /*generation*/,
+            const fixed_position& /*position*/,
+            const GSLrng_t& /*rng*/) const
+        /// Generate a mutation at a position chosen by the caller
+        /// rather than from this->region.  This allows a
+        /// MutationIntervalMap to use this object as the DFE of many
+        /// intervals, and FiniteSites to place mutations at integer sites.
+        /// Implemented by DFESregion.
+        {
+            throw std::runtime_error(
+                "this type cannot generate mutations at given positions");
+        }
+
+        virtual bool
+        supports_fixed_positions() const
+        /// True if generate_mutation is implemented.
+        {
+            return false;
+        }
+
         pybind11::tuple
         pickle_Sregion() const
         {
@@ -128,6 +128,7 @@ namespace fwdpy11
                     this->mut_lookup.emplace(pos, idx);
                     rv.push_back(idx);
                 }
+            ++this->effect_size_changes;
             return rv;
         }
 
@@ -2,6 +2,8 @@
 #define FWDPY11_PYPOPULATION_HPP__
 
 #include <tuple>
+#include <atomic>
+#include <cstdint>
 #include <algorithm>
 #include <gsl/gsl_randist.h>
 #include <fwdpp/forward_types.hpp>
@@ -14,6 +16,33 @@
 
 namespace fwdpy11
 {
+    struct population_serial
+    /// Identifies a population object.  Each construction, copy,
+    /// move, or assignment takes a value that no other population
+    /// has had, so that data derived from one population are not
+    /// mistaken for data of another one created at the same address.
+    /// Zero is never taken, and can be used to mean "no population".
+    {
+        std::uint64_t value;
+
+        population_serial() : value(next()) {}
+        population_serial(const population_serial &) : value(next()) {}
+
+        population_serial &
+        operator=(const population_serial &)
+        {
+            value = next();
+            return *this;
+        }
+
+        static std::uint64_t
+        next()
+        {
+            static std::atomic<std::uint64_t> counter{ 1 };
+            return counter++;
+        }
+    };
+
     template <typename mutation_type, typename mcont, typename gcont,
               typename mvector, typename ftvector, typename lookup_table_type>
     class PyPopulation
@@ -58,12 +87,20 @@ namespace fwdpy11
         std::vector<double> genetic_value_matrix,
             ancient_sample_genetic_value_matrix;
 
+        // Incremented when the effect sizes of existing mutations
+        // are changed, so that evolve functions can refresh anything
+        // derived from them.  Not compared or pickled.
+        std::uint64_t effect_size_changes;
+        // Identifies this object, for the same purpose.
+        // Not compared or pickled.
+        population_serial serial;
 
         PyPopulation(fwdpp::uint_t N_, const double L)
             : fwdpp_base{ N_ }, N{ N_ }, generation{ 0 }, diploid_metadata(N),
               ancient_sample_metadata{}, ancient_sample_records{},
               tables(init_tables(N_, L)), genetic_value_matrix{},
-              ancient_sample_genetic_value_matrix{}
+              ancient_sample_genetic_value_matrix{}, effect_size_changes{ 0 },
+              serial{}
         {
         }
 
@@ -77,7 +114,8 @@ namespace fwdpy11
               N{ N_ }, generation{ 0 }, diploid_metadata(N),
               ancient_sample_metadata{}, ancient_sample_records{},
               tables(std::numeric_limits<double>::max()),
-              genetic_value_matrix{}, ancient_sample_genetic_value_matrix{}
+              genetic_value_matrix{}, ancient_sample_genetic_value_matrix{},
+              effect_size_changes{ 0 }, serial{}
         {
         }
 
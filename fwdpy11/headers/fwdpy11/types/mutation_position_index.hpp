@@ -0,0 +1,705 @@
+//
+// Copyright (C) 2019 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_TYPES_MUTATION_POSITION_INDEX_HPP
+#define FWDPY11_TYPES_MUTATION_POSITION_INDEX_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+
+namespace fwdpy11
+{
+    class mutation_position_index
+    /// Maps mutation positions to indexes in the mutation container.
+    ///
+    /// This is an open-addressing hash table with linear probing,
+    /// stored in a single std::vector.  It replaces
+    /// std::unordered_multimap<double, std::uint32_t> as the mutation
+    /// lookup table of a population, and supports the part of that
+    /// interface used by fwdpp and fwdpy11.  Unlike the multimap,
+    /// inserting does not allocate unless the table grows, and the
+    /// probes of a lookup touch adjacent memory.
+    ///
+    /// Removed entries leave a marker behind, so erasing does not
+    /// invalidate other iterators.  The markers are discarded
+    /// when the table grows or is rebuilt.
+    ///
+    /// The iterators returned by find and equal_range only visit
+    /// entries with the requested position.  Iterating from begin()
+    /// to end() visits all entries in no particular order.
+    ///
+    /// For simulations of finite sites, index_sites additionally
+    /// keeps bitmaps of which integer positions are occupied.
+    /// This allows choosing among unoccupied sites directly.
+    /// Each bitmap covers one range of sites, so memory use
+    /// depends on the lengths of the indexed ranges and not
+    /// on their coordinates.
+    {
+      public:
+        using key_type = double;
+        using mapped_type = std::uint32_t;
+        using value_type = std::pair<double, mapped_type>;
+        using size_type = std::size_t;
+
+      private:
+        // Values of value_type::second that mark unused slots
+        enum : mapped_type
+        {
+            empty_slot = std::numeric_limits<mapped_type>::max(),
+            erased_slot = empty_slot - 1
+        };
+
+        struct site_block
+        // Bit i of bits is set if integer position
+        // first + i is occupied.  first is a multiple of 64.
+        {
+            std::uint64_t first, last;
+            std::vector<std::uint64_t> bits;
+        };
+
+        std::vector<value_type> slots;
+        size_type nentries, nerased;
+        // Disjoint blocks, sorted by position.
+        // Only maintained for ranges passed to index_sites.
+        std::vector<site_block> site_blocks;
+
+        static inline bool
+        is_entry(const value_type& slot)
+        {
+            return slot.second < erased_slot;
+        }
+
+        inline size_type
+        home(double pos) const
+        // Fibonacci hashing of the bits of pos.
+        {
+            if (pos == 0.0)
+                {
+                    pos = 0.0; // -0.0 == 0.0
+                }
+            std::uint64_t bits;
+            std::memcpy(&bits, &pos, sizeof(double));
+            bits ^= bits >> 32;
+            bits *= UINT64_C(0x9E3779B97F4A7C15);
+            return static_cast<size_type>(bits >> 32) & (slots.size() - 1);
+        }
+
+        inline size_type
+        next(const size_type i) const
+        {
+            return (i + 1) & (slots.size() - 1);
+        }
+
+        static size_type
+        capacity_for(const size_type n)
+        // A power of two that keeps the load below one half.
+        {
+            size_type c = 16;
+            while (c < 2 * n)
+                {
+                    c *= 2;
+                }
+            return c;
+        }
+
+        inline size_type
+        insert_slot(const double pos)
+        // Returns the first empty or erased slot
+        // in the probe sequence of pos.
+        {
+            auto i = home(pos);
+            while (is_entry(slots[i]))
+                {
+                    i = next(i);
+                }
+            return i;
+        }
+
+        site_block*
+        find_site_block(const double pos)
+        // The block containing pos, or nullptr
+        {
+            if (pos < 0.0 || pos != std::floor(pos))
+                {
+                    return nullptr;
+                }
+            for (auto& b : site_blocks)
+                {
+                    if (pos >= static_cast<double>(b.first)
+                        && pos < static_cast<double>(b.last))
+                        {
+                            return &b;
+                        }
+                }
+            return nullptr;
+        }
+
+        inline void
+        mark_site(const double pos)
+        {
+            auto b = find_site_block(pos);
+            if (b != nullptr)
+                {
+                    auto site = static_cast<std::uint64_t>(pos) - b->first;
+                    b->bits[site / 64] |= UINT64_C(1) << (site % 64);
+                }
+        }
+
+        inline void
+        unmark_site(const double pos)
+        // Call after removing an entry at pos.
+        {
+            auto b = find_site_block(pos);
+            if (b != nullptr && find(pos) == end())
+                {
+                    auto site = static_cast<std::uint64_t>(pos) - b->first;
+                    b->bits[site / 64] &= ~(UINT64_C(1) << (site % 64));
+                }
+        }
+
+        void
+        mark_all_sites()
+        {
+            for (auto& b : site_blocks)
+                {
+                    std::fill(b.bits.begin(), b.bits.end(), 0);
+                }
+            for (auto& slot : slots)
+                {
+                    if (is_entry(slot))
+                        {
+                            mark_site(slot.first);
+                        }
+                }
+        }
+
+        const site_block&
+        indexed_block(const std::uint64_t first,
+                      const std::uint64_t last) const
+        // The block containing sites [first, last)
+        {
+            for (auto& b : site_blocks)
+                {
+                    if (b.first <= first && last <= b.last)
+                        {
+                            return b;
+                        }
+                }
+            throw std::out_of_range("sites are not indexed");
+        }
+
+        static inline std::uint64_t
+        site_mask(const std::uint64_t word, const std::uint64_t first,
+                  const std::uint64_t last)
+        // The bits of word number word for sites in [first, last),
+        // which are relative to the start of a block
+        {
+            const auto lo = std::max(first, 64 * word) - 64 * word;
+            const auto hi = std::min(last, 64 * word + 64) - 64 * word;
+            const auto upper
+                = (hi == 64) ? ~UINT64_C(0) : (UINT64_C(1) << hi) - 1;
+            return upper & ~((UINT64_C(1) << lo) - 1);
+        }
+
+        static inline unsigned
+        popcount(std::uint64_t x)
+        {
+            unsigned n = 0;
+            for (; x; x &= x - 1)
+                {
+                    ++n;
+                }
+            return n;
+        }
+
+        void
+        rehash(const size_type capacity)
+        {
+            std::vector<value_type> old(capacity,
+                                        value_type(0.0, empty_slot));
+            old.swap(slots);
+            nerased = 0;
+            for (auto& slot : old)
+                {
+                    if (is_entry(slot))
+                        {
+                            slots[insert_slot(slot.first)] = slot;
+                        }
+                }
+        }
+
+        template <bool is_const> class iterator_t
+        {
+          private:
+            using table_t
+                = typename std::conditional<is_const,
+                                            const mutation_position_index,
+                                            mutation_position_index>::type;
+            table_t* table;
+            size_type index;
+            // If probing, only entries at pos are visited
+            bool probing;
+            double pos;
+
+            friend class mutation_position_index;
+
+            void
+            advance()
+            {
+                const auto& s = table->slots;
+                if (probing)
+                    {
+                        for (index = table->next(index);
+                             s[index].second != empty_slot;
+                             index = table->next(index))
+                            {
+                                if (is_entry(s[index])
+                                    && s[index].first == pos)
+                                    {
+                                        return;
+                                    }
+                            }
+                        index = s.size();
+                        return;
+                    }
+                do
+                    {
+                        ++index;
+                    }
+                while (index < s.size() && !is_entry(s[index]));
+            }
+
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = mutation_position_index::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference =
+                typename std::conditional<is_const, const value_type&,
+                                          value_type&>::type;
+            using pointer =
+                typename std::conditional<is_const, const value_type*,
+                                          value_type*>::type;
+
+            iterator_t(table_t* t, const size_type i, const bool p,
+                       const double x)
+                : table(t), index(i), probing(p), pos(x)
+            {
+            }
+
+            operator iterator_t<true>() const
+            {
+                return iterator_t<true>(table, index, probing, pos);
+            }
+
+            reference operator*() const
+            {
+                return table->slots[index];
+            }
+
+            pointer operator->() const
+            {
+                return &table->slots[index];
+            }
+
+            iterator_t&
+            operator++()
+            {
+                advance();
+                return *this;
+            }
+
+            iterator_t
+            operator++(int)
+            {
+                auto rv = *this;
+                advance();
+                return rv;
+            }
+
+            bool
+            operator==(const iterator_t& rhs) const
+            {
+                return index == rhs.index;
+            }
+
+            bool
+            operator!=(const iterator_t& rhs) const
+            {
+                return index != rhs.index;
+            }
+        };
+
+      public:
+        using iterator = iterator_t<false>;
+        using const_iterator = iterator_t<true>;
+
+        mutation_position_index()
+            : slots{}, nentries{ 0 }, nerased{ 0 }, site_blocks{}
+        {
+        }
+
+        inline size_type
+        size() const
+        {
+            return nentries;
+        }
+
+        inline bool
+        empty() const
+        {
+            return nentries == 0;
+        }
+
+        iterator
+        begin()
+        {
+            iterator rv(this, 0, false, 0.0);
+            if (!slots.empty() && !is_entry(slots[0]))
+                {
+                    rv.advance();
+                }
+            return rv;
+        }
+
+        const_iterator
+        begin() const
+        {
+            const_iterator rv(this, 0, false, 0.0);
+            if (!slots.empty() && !is_entry(slots[0]))
+                {
+                    rv.advance();
+                }
+            return rv;
+        }
+
+        iterator
+        end()
+        {
+            return iterator(this, slots.size(), false, 0.0);
+        }
+
+        const_iterator
+        end() const
+        {
+            return const_iterator(this, slots.size(), false, 0.0);
+        }
+
+        const_iterator
+        cbegin() const
+        {
+            return begin();
+        }
+
+        const_iterator
+        cend() const
+        {
+            return end();
+        }
+
+        iterator
+        find(const double pos)
+        {
+            auto i = static_cast<const mutation_position_index*>(this)
+                         ->find(pos)
+                         .index;
+            return iterator(this, i, true, pos);
+        }
+
+        const_iterator
+        find(const double pos) const
+        {
+            if (slots.empty())
+                {
+                    return end();
+                }
+            for (auto i = home(pos); slots[i].second != empty_slot;
+                 i = next(i))
+                {
+                    if (is_entry(slots[i]) && slots[i].first == pos)
+                        {
+                            return const_iterator(this, i, true, pos);
+                        }
+                }
+            return end();
+        }
+
+        std::pair<iterator, iterator>
+        equal_range(const double pos)
+        {
+            return std::make_pair(find(pos), end());
+        }
+
+        std::pair<const_iterator, const_iterator>
+        equal_range(const double pos) const
+        {
+            return std::make_pair(find(pos), end());
+        }
+
+        size_type
+        count(const double pos) const
+        {
+            auto r = equal_range(pos);
+            return static_cast<size_type>(std::distance(r.first, r.second));
+        }
+
+        void
+        reserve(const size_type n)
+        {
+            if (slots.size() < capacity_for(n))
+                {
+                    rehash(capacity_for(n));
+                }
+        }
+
+        iterator
+        emplace(const double pos, const mapped_type key)
+        {
+            if (4 * (nentries + nerased + 1) > 3 * slots.size())
+                {
+                    rehash(capacity_for(nentries + 1));
+                }
+            auto i = insert_slot(pos);
+            if (slots[i].second == erased_slot)
+                {
+                    --nerased;
+                }
+            slots[i] = value_type(pos, key);
+            ++nentries;
+            mark_site(pos);
+            return iterator(this, i, true, pos);
+        }
+
+        template <typename pair_type>
+        iterator
+        insert(const pair_type& p)
+        {
+            return emplace(p.first, static_cast<mapped_type>(p.second));
+        }
+
+        void
+        erase(const_iterator itr)
+        {
+            auto i = itr.index;
+            // An erased slot followed by an empty one
+            // can never be part of a probe sequence.
+            slots[i].second = (slots[next(i)].second == empty_slot)
+                                  ? empty_slot
+                                  : erased_slot;
+            nerased += (slots[i].second == erased_slot);
+            --nentries;
+            unmark_site(slots[i].first);
+        }
+
+        size_type
+        erase(const double pos)
+        {
+            size_type n = 0;
+            for (auto i = find(pos); i != end(); ++i)
+                {
+                    // Marking as erased keeps the probe
+                    // sequence intact for the loop.
+                    i->second = erased_slot;
+                    ++nerased;
+                    --nentries;
+                    ++n;
+                }
+            unmark_site(pos);
+            return n;
+        }
+
+        void
+        clear()
+        {
+            std::fill(slots.begin(), slots.end(),
+                      value_type(0.0, empty_slot));
+            for (auto& b : site_blocks)
+                {
+                    std::fill(b.bits.begin(), b.bits.end(), 0);
+                }
+            nentries = nerased = 0;
+        }
+
+        template <typename mcont_t, typename predicate>
+        void
+        rebuild(const mcont_t& mutations, const predicate& include)
+        /// Replace the contents with the positions of
+        /// mutations[i] for which include(i) is true.
+        {
+            const auto capacity = capacity_for(mutations.size());
+            if (slots.size() != capacity)
+                {
+                    slots.assign(capacity, value_type(0.0, empty_slot));
+                }
+            else
+                {
+                    clear();
+                }
+            nentries = nerased = 0;
+            for (std::size_t i = 0; i < mutations.size(); ++i)
+                {
+                    if (include(i))
+                        {
+                            slots[insert_slot(mutations[i].pos)]
+                                = value_type(mutations[i].pos,
+                                             static_cast<mapped_type>(i));
+                            ++nentries;
+                        }
+                }
+            if (!site_blocks.empty())
+                {
+                    mark_all_sites();
+                }
+        }
+
+        template <typename mcont_t>
+        void
+        rebuild(const mcont_t& mutations)
+        {
+            rebuild(mutations, [](std::size_t) { return true; });
+        }
+
+        void
+        index_sites(const std::uint64_t first, const std::uint64_t last)
+        /// Track the occupancy of integer positions first to last - 1.
+        /// Cheap if those sites are already tracked.  Ranges that
+        /// overlap ranges tracked earlier share a bitmap with them.
+        {
+            site_block merged{ first / 64 * 64, (last + 63) / 64 * 64, {} };
+            std::vector<site_block> blocks;
+            for (auto& b : site_blocks)
+                {
+                    if (b.first <= merged.first && merged.last <= b.last)
+                        {
+                            return;
+                        }
+                    if (b.last < merged.first || b.first > merged.last)
+                        {
+                            blocks.emplace_back(std::move(b));
+                        }
+                    else
+                        {
+                            merged.first = std::min(merged.first, b.first);
+                            merged.last = std::max(merged.last, b.last);
+                        }
+                }
+            merged.bits.assign((merged.last - merged.first) / 64, 0);
+            blocks.emplace_back(std::move(merged));
+            std::sort(blocks.begin(), blocks.end(),
+                      [](const site_block& a, const site_block& b) {
+                          return a.first < b.first;
+                      });
+            site_blocks.swap(blocks);
+            mark_all_sites();
+        }
+
+        inline bool
+        site_occupied(const std::uint64_t site) const
+        /// Requires that site has been tracked via index_sites.
+        {
+            const auto& b = indexed_block(site, site + 1);
+            const auto i = site - b.first;
+            return (b.bits[i / 64] >> (i % 64)) & 1;
+        }
+
+        std::uint64_t
+        unoccupied_sites(const std::uint64_t first,
+                         const std::uint64_t last) const
+        /// The number of unoccupied sites in [first, last),
+        /// which must have been tracked via one call to index_sites.
+        {
+            if (first >= last)
+                {
+                    return 0;
+                }
+            const auto& b = indexed_block(first, last);
+            const auto f = first - b.first, l = last - b.first;
+            std::uint64_t n = 0;
+            for (auto w = f / 64; w <= (l - 1) / 64; ++w)
+                {
+                    n += popcount(~b.bits[w] & site_mask(w, f, l));
+                }
+            return n;
+        }
+
+        std::uint64_t
+        unoccupied_site(const std::uint64_t first, const std::uint64_t last,
+                        std::uint64_t n) const
+        /// Returns the n-th unoccupied site in [first, last),
+        /// counting from zero.  Requires n < unoccupied_sites(first, last).
+        {
+            const auto& b = indexed_block(first, last);
+            const auto f = first - b.first, l = last - b.first;
+            for (auto w = f / 64; f < l && w <= (l - 1) / 64; ++w)
+                {
+                    auto bits = ~b.bits[w] & site_mask(w, f, l);
+                    auto nw = popcount(bits);
+                    if (n < nw)
+                        {
+                            for (; n; --n)
+                                {
+                                    bits &= bits - 1;
+                                }
+                            // Index of the lowest set bit
+                            return b.first + 64 * w
+                                   + popcount((bits & (~bits + 1)) - 1);
+                        }
+                    n -= nw;
+                }
+            throw std::out_of_range("too few unoccupied sites");
+        }
+
+        bool
+        operator==(const mutation_position_index& rhs) const
+        /// True if both contain the same entries,
+        /// counting repeated entries, in any order.
+        {
+            if (nentries != rhs.nentries)
+                {
+                    return false;
+                }
+            for (auto& e : *this)
+                {
+                    auto l = equal_range(e.first);
+                    auto r = rhs.equal_range(e.first);
+                    if (std::count(l.first, l.second, e)
+                        != std::count(r.first, r.second, e))
+                        {
+                            return false;
+                        }
+                }
+            return true;
+        }
+
+        bool
+        operator!=(const mutation_position_index& rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+} // namespace fwdpy11
+
+#endif
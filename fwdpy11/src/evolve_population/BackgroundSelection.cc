@@ -0,0 +1,74 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/evolve/background_selection.hpp>
+
+namespace py = pybind11;
+
+void
+init_BackgroundSelection(py::module &m)
+{
+    py::class_<fwdpy11::BackgroundSelection>(m, "BackgroundSelection",
+                                             R"delim(
+        Fitness-class approximation to background selection.
+
+        Weakly deleterious mutations in a set of non-overlapping blocks
+        are not stored as :class:`fwdpy11.Mutation` objects.  Instead,
+        each haploid genome carries the number of deleterious mutations
+        in each block.  A block is inherited as a unit from the parental
+        genome that is transmitted at the block's midpoint, and gains a
+        Poisson number of new mutations each generation.  Each mutation
+        in a block multiplies fitness by :math:`1 - s`.
+
+        Background selection only works with :func:`fwdpy11.evolve_genomes`,
+        to which an instance is passed.  It is not supported with tree
+        sequence recording.  The fitness
+        due to background selection multiplies the fitness obtained from
+        the genetic value model.  Explicit mutations, such as those
+        from :attr:`fwdpy11.ModelParams.sregions`, are unaffected.
+
+        The counts persist between calls to :func:`fwdpy11.evolve_genomes`
+        that continue the simulation of the same population.  They are
+        discarded, and start at zero, when the instance is used with
+        another population, including a copy, or after the population
+        has been evolved without it.  Changes to the order of
+        :attr:`fwdpy11.DiploidPopulation.diploids` between calls are
+        not detected.
+        )delim")
+        .def(py::init<
+                 const std::vector<std::tuple<double, double, double, double>>
+                     &>(),
+             py::arg("blocks"),
+             R"delim(
+        :param blocks: (beg, end, u, s) for each block
+        :type blocks: list
+
+        `u` is the deleterious mutation rate per haploid genome per
+        generation in the block, and `s` the fitness cost of each mutation.
+        Blocks must be sorted by position and must not overlap.
+        )delim")
+        .def_property_readonly(
+            "nblocks", &fwdpy11::BackgroundSelection::nblocks,
+            "Number of blocks.")
+        .def_property_readonly(
+            "loads",
+            [](const fwdpy11::BackgroundSelection &self) {
+                const auto nb = self.nblocks();
+                py::array_t<std::uint32_t> rv(
+                    { self.loads.size() / nb, nb });
+                std::copy(begin(self.loads), end(self.loads),
+                          rv.mutable_data());
+                return rv;
+            },
+            R"delim(
+        Copy of the number of deleterious mutations in each block, as a
+        2d array.  Row 2i + j is haploid genome j of diploid i.
+        Fixed mutations have been subtracted.
+        )delim")
+        .def("fitness", &fwdpy11::BackgroundSelection::fitness,
+             py::arg("diploid"),
+             "Fitness of a diploid due to background selection.")
+        .def("reset", &fwdpy11::BackgroundSelection::reset,
+             "Discard the counts, which start at zero in the next "
+             "simulation.");
+}
@@ -0,0 +1,70 @@
+#include <vector>
+#include <limits>
+#include <utility>
+#include <stdexcept>
+#include <fwdpy11/types/DiploidPopulation.hpp>
+
+bool
+compact_gametes(fwdpy11::DiploidPopulation &pop,
+                const double min_extant_fraction)
+// Removes gametes with n == 0 from pop.gametes,
+// remaps the gamete indexes stored in pop.diploids,
+// and releases any excess capacity held by the
+// remaining gametes.  This is only done if the
+// fraction of extant gametes is < min_extant_fraction.
+// Returns true if the container was compacted.
+{
+    if (pop.gametes.empty())
+        {
+            return false;
+        }
+    std::size_t nextant = 0;
+    for (auto &g : pop.gametes)
+        {
+            nextant += (g.n > 0);
+        }
+    if (static_cast<double>(nextant)
+        >= min_extant_fraction * static_cast<double>(pop.gametes.size()))
+        {
+            return false;
+        }
+
+    std::vector<std::size_t> new_index(
+        pop.gametes.size(), std::numeric_limits<std::size_t>::max());
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < pop.gametes.size(); ++i)
+        {
+            if (pop.gametes[i].n)
+                {
+                    if (i != next)
+                        {
+                            // Swapping, vs assigning, sends the
+                            // extinct gamete's storage to the tail
+                            // of the container, where it is freed
+                            // by the call to erase below.
+                            std::swap(pop.gametes[next], pop.gametes[i]);
+                        }
+                    new_index[i] = next++;
+                }
+        }
+    pop.gametes.erase(pop.gametes.begin() + next, pop.gametes.end());
+    pop.gametes.shrink_to_fit();
+    for (auto &g : pop.gametes)
+        {
+            g.mutations.shrink_to_fit();
+            g.smutations.shrink_to_fit();
+        }
+
+    for (auto &dip : pop.diploids)
+        {
+            dip.first = new_index[dip.first];
+            dip.second = new_index[dip.second];
+            if (dip.first == std::numeric_limits<std::size_t>::max()
+                || dip.second == std::numeric_limits<std::size_t>::max())
+                {
+                    throw std::runtime_error(
+                        "diploid refers to an extinct gamete");
+                }
+        }
+    return true;
+}
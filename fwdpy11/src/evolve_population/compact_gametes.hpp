@@ -0,0 +1,9 @@
+#ifndef FWDPY11_EVOLVE_COMPACT_GAMETES_HPP
+#define FWDPY11_EVOLVE_COMPACT_GAMETES_HPP
+
+#include <fwdpy11/types/DiploidPopulation.hpp>
+
+bool compact_gametes(fwdpy11::DiploidPopulation &pop,
+                     const double min_extant_fraction);
+
+#endif
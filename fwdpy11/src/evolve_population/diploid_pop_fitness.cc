@@ -1,77 +1,110 @@
+#include <memory>
 #include "diploid_pop_fitness.hpp"
 #include "genetic_value_common.hpp"
+#include "parallel_evaluation.hpp"
 
 template <typename update_genotype_matrix>
-fwdpp::fwdpp_internal::gsl_ran_discrete_t_ptr
+void
 calculate_fitness_details(
     const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulation &pop,
     const fwdpy11::DiploidPopulationGeneticValue &genetic_value_fxn,
     std::vector<fwdpy11::DiploidMetadata> &new_metadata,
-    std::vector<double> &new_diploid_gvalues, const update_genotype_matrix um)
+    std::vector<double> &new_diploid_gvalues, const update_genotype_matrix um,
+    parallel_evaluation_workspace *parallel_evaluation,
+    const fwdpy11::BackgroundSelection *background_selection,
+    fwdpy11::discrete_sampler &lookup)
 {
     // Calculate parental fitnesses
-    std::vector<double> parental_fitnesses(pop.diploids.size());
-    double sum_parental_fitnesses = 0.0;
     new_metadata.resize(pop.N);
     resize_genotype_matrix(new_diploid_gvalues,
                            pop.N * genetic_value_fxn.total_dim, um);
-    auto gvoffset = new_diploid_gvalues.data();
-    for (std::size_t i = 0; i < pop.diploids.size();
-         ++i, gvoffset += genetic_value_fxn.total_dim)
+    for (std::size_t i = 0; i < pop.diploids.size(); ++i)
         {
             new_metadata[i] = pop.diploid_metadata[i];
-            genetic_value_fxn(rng, i, pop, new_metadata[i]);
-            copy_genetic_values(gvoffset, genetic_value_fxn.gvalues, um);
-            parental_fitnesses[i] = new_metadata[i].w;
-            sum_parental_fitnesses += parental_fitnesses[i];
+        }
+    if (parallel_evaluation != nullptr
+        && genetic_value_fxn.supports_parallel_evaluation())
+        {
+            (*parallel_evaluation)(
+                rng, pop, genetic_value_fxn, new_metadata,
+                genetic_value_buffer(new_diploid_gvalues, um));
+        }
+    else
+        {
+            genetic_value_fxn.evaluate_population(
+                rng, pop, new_metadata,
+                genetic_value_buffer(new_diploid_gvalues, um));
+        }
+    if (background_selection != nullptr)
+        {
+            background_selection->apply(new_metadata);
+        }
+    double sum_parental_fitnesses = 0.0;
+    bool negative_fitness = false;
+    for (std::size_t i = 0; i < pop.diploids.size(); ++i)
+        {
+            sum_parental_fitnesses += new_metadata[i].w;
+            negative_fitness = negative_fitness || (new_metadata[i].w < 0.0);
         }
     pop.diploid_metadata.swap(new_metadata);
     pop.genetic_value_matrix.swap(new_diploid_gvalues);
     // If the sum of parental fitnesses is not finite,
-    // then the genetic value calculator returned a non-finite value/
-    // Unfortunately, gsl_ran_discrete_preproc allows such values through
-    // without raising an error, so we have to check things here.
+    // then the genetic value calculator returned a non-finite value.
     if (!std::isfinite(sum_parental_fitnesses))
         {
             throw std::runtime_error("non-finite fitnesses encountered");
         }
-
-    auto rv = fwdpp::fwdpp_internal::gsl_ran_discrete_t_ptr(
-        gsl_ran_discrete_preproc(parental_fitnesses.size(),
-                                 parental_fitnesses.data()));
-    if (rv == nullptr)
+    if (negative_fitness)
         {
-            // This is due to negative fitnesses
             throw std::runtime_error(
                 "fitness lookup table could not be generated");
         }
-    return rv;
+    // The table is rebuilt in place, reusing its storage
+    const auto &metadata = pop.diploid_metadata;
+    lookup.assign(pop.diploids.size(), [&metadata](const std::size_t i) {
+        return metadata[i].w;
+    });
 }
 
-std::function<fwdpp::fwdpp_internal::gsl_ran_discrete_t_ptr(
-    const fwdpy11::GSLrng_t &g, fwdpy11::DiploidPopulation &,
-    const fwdpy11::DiploidPopulationGeneticValue &,
-    std::vector<fwdpy11::DiploidMetadata> &, std::vector<double> &)>
-wrap_calculate_fitness_DiploidPopulation(bool update_genotype_matrix)
+std::function<void(const fwdpy11::GSLrng_t &g, fwdpy11::DiploidPopulation &,
+                   const fwdpy11::DiploidPopulationGeneticValue &,
+                   std::vector<fwdpy11::DiploidMetadata> &,
+                   std::vector<double> &, fwdpy11::discrete_sampler &)>
+wrap_calculate_fitness_DiploidPopulation(
+    bool update_genotype_matrix, unsigned nthreads,
+    const fwdpy11::BackgroundSelection *background_selection)
 {
+    // Shared so that the returned function remains copyable
+    std::shared_ptr<parallel_evaluation_workspace> workspace(nullptr);
+    if (nthreads > 0)
+        {
+            workspace.reset(new parallel_evaluation_workspace(nthreads));
+        }
     if (update_genotype_matrix)
         {
-            return [](const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulation &pop,
-                      const fwdpy11::DiploidPopulationGeneticValue &genetic_value_fxn,
-                      std::vector<fwdpy11::DiploidMetadata> &new_metadata,
-                      std::vector<double> &new_diploid_gvalues) {
-                return calculate_fitness_details(
+            return [workspace, background_selection](
+                       const fwdpy11::GSLrng_t &rng,
+                       fwdpy11::DiploidPopulation &pop,
+                       const fwdpy11::DiploidPopulationGeneticValue
+                           &genetic_value_fxn,
+                       std::vector<fwdpy11::DiploidMetadata> &new_metadata,
+                       std::vector<double> &new_diploid_gvalues,
+                       fwdpy11::discrete_sampler &lookup) {
+                calculate_fitness_details(
                     rng, pop, genetic_value_fxn, new_metadata,
-                    new_diploid_gvalues, std::true_type());
+                    new_diploid_gvalues, std::true_type(), workspace.get(),
+                    background_selection, lookup);
             };
         }
-    return [](const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulation &pop,
-              const fwdpy11::DiploidPopulationGeneticValue &genetic_value_fxn,
-              std::vector<fwdpy11::DiploidMetadata> &new_metadata,
-              std::vector<double> &new_diploid_gvalues) {
-        return calculate_fitness_details(rng, pop, genetic_value_fxn,
-                                         new_metadata, new_diploid_gvalues,
-                                         std::false_type());
+    return [workspace, background_selection](
+               const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulation &pop,
+               const fwdpy11::DiploidPopulationGeneticValue &genetic_value_fxn,
+               std::vector<fwdpy11::DiploidMetadata> &new_metadata,
+               std::vector<double> &new_diploid_gvalues,
+               fwdpy11::discrete_sampler &lookup) {
+        calculate_fitness_details(rng, pop, genetic_value_fxn, new_metadata,
+                                  new_diploid_gvalues, std::false_type(),
+                                  workspace.get(), background_selection,
+                                  lookup);
     };
 }
-
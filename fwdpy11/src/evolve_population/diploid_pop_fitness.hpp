@@ -1,14 +1,24 @@
 #ifndef FWDPY11_TSEVOLVE_SLOCUS_FITNESS_HPP
 #define FWDPY11_TSEVOLVE_SLOCUS_FITNESS_HPP
 
-#include <fwdpp/internal/gsl_discrete.hpp>
+#include <functional>
+#include <fwdpy11/evolve/discrete_sampler.hpp>
+#include <fwdpy11/evolve/background_selection.hpp>
 #include <fwdpy11/types/DiploidPopulation.hpp>
 #include <fwdpy11/genetic_values/DiploidPopulationGeneticValue.hpp>
 
-std::function<fwdpp::fwdpp_internal::gsl_ran_discrete_t_ptr(
-    const fwdpy11::GSLrng_t &g, fwdpy11::DiploidPopulation &,
-    const fwdpy11::DiploidPopulationGeneticValue &,
-    std::vector<fwdpy11::DiploidMetadata> &, std::vector<double> &)>
-wrap_calculate_fitness_DiploidPopulation(bool update_genotype_matrix);
+std::function<void(const fwdpy11::GSLrng_t &g, fwdpy11::DiploidPopulation &,
+                   const fwdpy11::DiploidPopulationGeneticValue &,
+                   std::vector<fwdpy11::DiploidMetadata> &,
+                   std::vector<double> &, fwdpy11::discrete_sampler &)>
+wrap_calculate_fitness_DiploidPopulation(
+    bool update_genotype_matrix, unsigned nthreads = 0,
+    const fwdpy11::BackgroundSelection *background_selection = nullptr);
+// If nthreads > 0, models that support it are evaluated
+// by parallel_evaluation_workspace using nthreads threads.
+// If background_selection is not nullptr, it is applied to
+// the fitnesses, whose lengths must match its loads.
+// The returned function rebuilds its last argument, which
+// samples parents proportionally to their fitness.
 
 #endif
@@ -14,17 +14,15 @@ resize_genotype_matrix(std::vector<double> & /*new_diploid_gvalues*/,
 {
 }
 
-void
-copy_genetic_values(double *beg, const std::vector<double> &gvalues,
-                    std::true_type)
+double *
+genetic_value_buffer(std::vector<double> &new_diploid_gvalues, std::true_type)
 {
-    std::copy(begin(gvalues), end(gvalues), beg);
+    return new_diploid_gvalues.data();
 }
 
-void
-copy_genetic_values(double * /*beg*/,
-                    const std::vector<double> & /*genetic_value_fxn*/,
-                    std::false_type)
+double *
+genetic_value_buffer(std::vector<double> & /*new_diploid_gvalues*/,
+                     std::false_type)
 {
+    return nullptr;
 }
-
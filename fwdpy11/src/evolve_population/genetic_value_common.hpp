@@ -10,11 +10,10 @@ void resize_genotype_matrix(std::vector<double> &new_diploid_gvalues,
 void resize_genotype_matrix(std::vector<double> & /*new_diploid_gvalues*/,
                             std::size_t /*newsize*/, std::false_type);
 
-void copy_genetic_values(double *beg, const std::vector<double> &gvalues,
-                         std::true_type);
+double *genetic_value_buffer(std::vector<double> &new_diploid_gvalues,
+                             std::true_type);
 
-void copy_genetic_values(double * /*beg*/,
-                         const std::vector<double> & /*genetic_value_fxn*/,
-                         std::false_type);
+double *genetic_value_buffer(std::vector<double> & /*new_diploid_gvalues*/,
+                             std::false_type);
 
 #endif
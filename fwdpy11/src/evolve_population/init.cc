@@ -1,9 +1,11 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/functional.h>
+#include "parallel_evaluation.hpp"
 
 namespace py = pybind11;
 
 void init_no_stopping(py::module &);
+void init_BackgroundSelection(py::module &);
 void init_evolve_with_tree_sequences(py::module &);
 void init_evolve_without_tree_sequences(py::module &m);
 
@@ -11,7 +13,11 @@ void
 init_evolution_functions(py::module &m)
 {
     init_no_stopping(m);
+    init_BackgroundSelection(m);
     init_evolve_with_tree_sequences(m);
     init_evolve_without_tree_sequences(m);
+    m.def("_parallel_evaluation_count", &parallel_evaluation_count,
+          "For testing: the number of generations whose fitnesses "
+          "were calculated by several threads.");
 }
 
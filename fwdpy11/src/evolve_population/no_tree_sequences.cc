@@ -35,9 +35,11 @@
 #include <fwdpy11/genetic_values/DiploidPopulationGeneticValue.hpp>
 #include <fwdpy11/genetic_values/GeneticValueToFitness.hpp>
 #include <fwdpy11/evolve/DiploidPopulation_generation.hpp>
+#include <fwdpy11/evolve/background_selection.hpp>
 #include <fwdpy11/regions/RecombinationRegions.hpp>
 #include <fwdpy11/regions/MutationRegions.hpp>
 #include "diploid_pop_fitness.hpp"
+#include "compact_gametes.hpp"
 
 namespace py = pybind11;
 
@@ -62,6 +64,27 @@ handle_fixations(const bool remove_selected_fixations,
                               2 * pop.N, remove_selected_fixations);
 }
 
+template <typename background_t, typename... evolve_generation_args>
+void
+dispatch_evolve_generation(fwdpy11::haploid_effects_cache *haploid_cache,
+                           background_t &background,
+                           evolve_generation_args &&... args)
+{
+    if (haploid_cache != nullptr)
+        {
+            fwdpy11::evolve_generation(
+                std::forward<evolve_generation_args>(args)..., *haploid_cache,
+                background);
+        }
+    else
+        {
+            fwdpy11::detail::no_gamete_observer no_observer;
+            fwdpy11::evolve_generation(
+                std::forward<evolve_generation_args>(args)..., no_observer,
+                background);
+        }
+}
+
 void
 evolve_without_tree_sequences(
     const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulation &pop,
@@ -70,7 +93,9 @@ evolve_without_tree_sequences(
     const fwdpy11::MutationRegions &mmodel, const fwdpy11::GeneticMap &rmodel,
     fwdpy11::DiploidPopulationGeneticValue &genetic_value_fxn,
     fwdpy11::DiploidPopulation_temporal_sampler recorder,
-    const double selfing_rate, const bool remove_selected_fixations)
+    const double selfing_rate, const bool remove_selected_fixations,
+    const double gamete_compaction_threshold, const unsigned nthreads,
+    fwdpy11::BackgroundSelection *background_selection)
 {
     //validate the input params
     if (!std::isfinite(mu_neutral))
@@ -98,6 +123,13 @@ evolve_without_tree_sequences(
         {
             throw std::invalid_argument("empty list of population sizes");
         }
+    if (!std::isfinite(gamete_compaction_threshold)
+        || gamete_compaction_threshold < 0.0
+        || gamete_compaction_threshold > 1.0)
+        {
+            throw std::invalid_argument(
+                "gamete compaction threshold must be in [0, 1]");
+        }
 
     // E[S_{2N}] I got the expression from Ewens.
     pop.mutations.reserve(std::ceil(
@@ -118,18 +150,33 @@ evolve_without_tree_sequences(
     // so we must call update(...) prior to calculating fitness,
     // else bad stuff like segfaults could happen.
     genetic_value_fxn.update(pop);
+    auto haploid_cache = genetic_value_fxn.tracked_haploid_cache();
+    if (haploid_cache != nullptr)
+        {
+            haploid_cache->rebuild(pop.gametes);
+        }
+    auto effect_size_changes = pop.effect_size_changes;
+    if (background_selection != nullptr)
+        {
+            background_selection->initialize(pop);
+        }
     std::vector<fwdpy11::DiploidMetadata> new_metadata(pop.N);
     std::vector<double> new_diploid_gvalues;
-    auto calculate_fitness = wrap_calculate_fitness_DiploidPopulation(false);
-    auto lookup = calculate_fitness(rng, pop, genetic_value_fxn, new_metadata,
-                                    new_diploid_gvalues);
+    auto calculate_fitness = wrap_calculate_fitness_DiploidPopulation(
+        false, nthreads, background_selection);
+    fwdpy11::discrete_sampler lookup;
+    const auto update_fitness = [&]() {
+        calculate_fitness(rng, pop, genetic_value_fxn, new_metadata,
+                          new_diploid_gvalues, lookup);
+    };
+    update_fitness();
 
     // Generate our fxns for picking parents
 
     // Because lambdas that capture by reference do a "late" binding of
     // params, this is safe w.r.to updating lookup after each generation.
     const auto pick_first_parent = [&rng, &lookup]() {
-        return gsl_ran_discrete(rng.get(), lookup.get());
+        return lookup(rng);
     };
 
     const auto pick_second_parent
@@ -140,7 +187,7 @@ evolve_without_tree_sequences(
                   {
                       return p1;
                   }
-              return gsl_ran_discrete(rng.get(), lookup.get());
+              return lookup(rng);
           };
 
     const auto generate_offspring_metadata
@@ -158,18 +205,62 @@ evolve_without_tree_sequences(
         {
             ++pop.generation;
             const auto N_next = popsizes.at(gen);
-            fwdpy11::evolve_generation(
-                rng, pop, N_next, mu_neutral + mu_selected, bound_mmodel,
-                bound_rmodel, pick_first_parent, pick_second_parent,
-                generate_offspring_metadata);
+            if (background_selection != nullptr)
+                {
+                    dispatch_evolve_generation(
+                        haploid_cache, *background_selection, rng, pop,
+                        N_next, mu_neutral + mu_selected, bound_mmodel,
+                        bound_rmodel, pick_first_parent, pick_second_parent,
+                        generate_offspring_metadata);
+                    background_selection->synchronize(pop);
+                }
+            else
+                {
+                    fwdpy11::detail::no_background_selection no_background;
+                    dispatch_evolve_generation(
+                        haploid_cache, no_background, rng, pop, N_next,
+                        mu_neutral + mu_selected, bound_mmodel, bound_rmodel,
+                        pick_first_parent, pick_second_parent,
+                        generate_offspring_metadata);
+                }
             handle_fixations(remove_selected_fixations, N_next, pop);
+            bool compacted = false;
+            if (gamete_compaction_threshold > 0.0)
+                {
+                    compacted
+                        = compact_gametes(pop, gamete_compaction_threshold);
+                }
+            if (haploid_cache != nullptr)
+                {
+                    if (compacted)
+                        {
+                            haploid_cache->rebuild(pop.gametes);
+                        }
+                    else
+                        {
+                            haploid_cache->validate(pop.gametes);
+                        }
+                }
 
             pop.N = N_next;
             // TODO: deal with random effects
             genetic_value_fxn.update(pop);
-            lookup = calculate_fitness(rng, pop, genetic_value_fxn,
-                                       new_metadata, new_diploid_gvalues);
+            update_fitness();
             recorder(pop); // The user may now analyze the pop'n
+            if (pop.effect_size_changes != effect_size_changes)
+                {
+                    // The recorder changed the effect sizes
+                    // of existing mutations.
+                    if (haploid_cache != nullptr)
+                        {
+                            haploid_cache->rebuild(pop.gametes);
+                        }
+                }
+            effect_size_changes = pop.effect_size_changes;
+        }
+    if (haploid_cache != nullptr)
+        {
+            haploid_cache->invalidate();
         }
 }
 
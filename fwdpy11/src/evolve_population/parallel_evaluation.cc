@@ -0,0 +1,163 @@
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <gsl/gsl_rng.h>
+#include "parallel_evaluation.hpp"
+
+constexpr std::size_t parallel_evaluation_workspace::block_size;
+
+namespace
+{
+    std::atomic<std::uint64_t> evaluations(0);
+
+    unsigned long
+    block_seed(const std::uint64_t seed, const std::uint64_t block)
+    // splitmix64 of seed and block index
+    {
+        std::uint64_t z = seed + (block + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return static_cast<unsigned long>(z ^ (z >> 31));
+    }
+} // namespace
+
+std::uint64_t
+parallel_evaluation_count()
+{
+    return evaluations.load();
+}
+
+parallel_evaluation_workspace::parallel_evaluation_workspace(
+    const unsigned nthreads_)
+    : nthreads(nthreads_), block_rngs{}, threads{}, mutex{}, job_ready{},
+      job_done{}, job{}, job_id(0), nbusy(0), stopping(false)
+{
+    if (nthreads == 0)
+        {
+            throw std::invalid_argument("number of threads must be > 0");
+        }
+    for (unsigned t = 1; t < nthreads; ++t)
+        {
+            threads.emplace_back(&parallel_evaluation_workspace::thread_loop,
+                                 this);
+        }
+}
+
+parallel_evaluation_workspace::~parallel_evaluation_workspace()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    job_ready.notify_all();
+    for (auto &t : threads)
+        {
+            t.join();
+        }
+}
+
+void
+parallel_evaluation_workspace::thread_loop()
+{
+    std::uint64_t last_job = 0;
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                job_ready.wait(lock, [this, last_job]() {
+                    return stopping || job_id != last_job;
+                });
+                if (stopping)
+                    {
+                        return;
+                    }
+                last_job = job_id;
+            }
+            job();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--nbusy == 0)
+                    {
+                        job_done.notify_one();
+                    }
+            }
+        }
+}
+
+void
+parallel_evaluation_workspace::run(const std::function<void()> &worker)
+// Runs worker on all threads and returns when all are done.
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = worker;
+        nbusy = threads.size();
+        ++job_id;
+    }
+    job_ready.notify_all();
+    worker();
+    std::unique_lock<std::mutex> lock(mutex);
+    job_done.wait(lock, [this]() { return nbusy == 0; });
+}
+
+void
+parallel_evaluation_workspace::
+operator()(const fwdpy11::GSLrng_t &rng, const fwdpy11::DiploidPopulation &pop,
+           const fwdpy11::DiploidPopulationGeneticValue &genetic_value_fxn,
+           std::vector<fwdpy11::DiploidMetadata> &metadata,
+           double *genetic_values)
+{
+    ++evaluations;
+    const std::size_t N = pop.diploids.size();
+    const std::size_t nblocks = (N + block_size - 1) / block_size;
+    // One draw per generation, regardless of N or nthreads
+    const std::uint64_t seed = gsl_rng_get(rng.get());
+    while (block_rngs.size() < nblocks)
+        {
+            block_rngs.emplace_back(new fwdpy11::GSLrng_t(0));
+        }
+    for (std::size_t b = 0; b < nblocks; ++b)
+        {
+            gsl_rng_set(block_rngs[b]->get(), block_seed(seed, b));
+        }
+
+    std::atomic<std::size_t> next_block(0);
+    std::exception_ptr error = nullptr;
+    std::atomic<bool> failed(false);
+    const auto worker = [&]() {
+        try
+            {
+                for (std::size_t b = next_block++; b < nblocks && !failed;
+                     b = next_block++)
+                    {
+                        genetic_value_fxn.evaluate_range(
+                            *block_rngs[b], pop, metadata, genetic_values,
+                            b * block_size, std::min(N, (b + 1) * block_size));
+                    }
+            }
+        catch (...)
+            {
+                if (!failed.exchange(true))
+                    {
+                        error = std::current_exception();
+                    }
+            }
+    };
+    if (nblocks < 2)
+        {
+            worker();
+        }
+    else
+        {
+            run(worker);
+        }
+    if (error != nullptr)
+        {
+            std::rethrow_exception(error);
+        }
+}
@@ -0,0 +1,66 @@
+#ifndef FWDPY11_EVOLVE_PARALLEL_EVALUATION_HPP
+#define FWDPY11_EVOLVE_PARALLEL_EVALUATION_HPP
+
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/types/DiploidPopulation.hpp>
+#include <fwdpy11/genetic_values/DiploidPopulationGeneticValue.hpp>
+
+class parallel_evaluation_workspace
+// Evaluates genetic values and fitnesses using several threads.
+// Diploids are processed in blocks of a fixed size.  Each block
+// draws its noise from its own RNG, seeded from a single value
+// drawn from the simulation's RNG, so the results do not depend
+// on the number of threads.
+//
+// The nthreads - 1 helper threads are started by the constructor
+// and wait for work between calls, so that threads are not created
+// every generation.  The calling thread does its share of each call.
+{
+  private:
+    unsigned nthreads;
+    std::vector<std::unique_ptr<fwdpy11::GSLrng_t>> block_rngs;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable job_ready, job_done;
+    // The current job, run by all threads.  It must not throw.
+    std::function<void()> job;
+    // Incremented for each job
+    std::uint64_t job_id;
+    // Number of helper threads still running the current job
+    std::size_t nbusy;
+    bool stopping;
+
+    void thread_loop();
+    void run(const std::function<void()> &worker);
+
+  public:
+    static constexpr std::size_t block_size = 1024;
+
+    explicit parallel_evaluation_workspace(const unsigned nthreads_);
+    ~parallel_evaluation_workspace();
+    parallel_evaluation_workspace(const parallel_evaluation_workspace &)
+        = delete;
+    parallel_evaluation_workspace &
+    operator=(const parallel_evaluation_workspace &)
+        = delete;
+    void
+    operator()(const fwdpy11::GSLrng_t &rng,
+               const fwdpy11::DiploidPopulation &pop,
+               const fwdpy11::DiploidPopulationGeneticValue &genetic_value_fxn,
+               std::vector<fwdpy11::DiploidMetadata> &metadata,
+               double *genetic_values);
+};
+
+// Number of calls to parallel_evaluation_workspace::operator()
+// in this process.  Used by tests to check that the parallel
+// path was taken.
+std::uint64_t parallel_evaluation_count();
+
+#endif
@@ -86,10 +86,6 @@ remove_extinct_mutations(fwdpy11::Population& pop)
         }
 
     // Easiest way to update the lookup table:
-    pop.mut_lookup.clear();
-    for (std::size_t i = 0; i < pop.mutations.size(); ++i)
-        {
-            pop.mut_lookup.insert(std::make_pair(pop.mutations[i].pos, i));
-        }
+    pop.mut_lookup.rebuild(pop.mutations);
 }
 
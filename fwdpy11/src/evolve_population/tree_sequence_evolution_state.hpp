@@ -0,0 +1,54 @@
+#ifndef FWDPY11_EVOLVE_TREE_SEQUENCE_EVOLUTION_STATE_HPP
+#define FWDPY11_EVOLVE_TREE_SEQUENCE_EVOLUTION_STATE_HPP
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpp/ts/table_simplifier.hpp>
+#include <fwdpp/simfunctions/recycling.hpp>
+#include <fwdpy11/evolve/discrete_sampler.hpp>
+#include <fwdpy11/types/DiploidPopulation.hpp>
+
+struct TreeSequenceEvolutionState
+// The data of a simulation with tree sequence recording that
+// must persist when the simulation is run in several steps
+// via repeated calls to evolve_with_tree_sequences.
+// A default-constructed object is initialized by the first
+// of those calls.
+{
+    bool initialized, simplified, finished;
+    // The number of elements of the list of population
+    // sizes that have been simulated so far.
+    std::uint32_t generations_completed;
+    fwdpp::ts::TS_NODE_INT first_parental_index, next_index;
+    std::unique_ptr<fwdpp::ts::table_simplifier> simplifier;
+    fwdpp::flagged_mutation_queue mutation_recycling_bin;
+    fwdpy11::discrete_sampler lookup;
+    std::vector<fwdpy11::DiploidMetadata> new_metadata;
+    std::vector<double> new_diploid_gvalues;
+    // Workspace for the offspring generation
+    fwdpy11::dipvector_t offspring;
+    std::vector<fwdpy11::DiploidMetadata> offspring_metadata;
+    // The largest node ID that may be assigned.  Only lowered
+    // by tests of the handling of full node tables.
+    std::int64_t max_node_id;
+    // If true, the generation loop is not specialized
+    // for the model.  Only set by tests.
+    bool generic_generation_loop;
+
+    TreeSequenceEvolutionState()
+        : initialized(false), simplified(false), finished(false),
+          generations_completed(0), first_parental_index(0), next_index(0),
+          simplifier(nullptr),
+          mutation_recycling_bin(fwdpp::empty_mutation_queue()),
+          lookup{}, new_metadata{}, new_diploid_gvalues{},
+          offspring{}, offspring_metadata{},
+          max_node_id(std::numeric_limits<fwdpp::ts::TS_NODE_INT>::max()),
+          generic_generation_loop(false)
+    {
+    }
+};
+
+#endif
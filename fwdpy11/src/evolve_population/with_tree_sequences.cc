@@ -24,10 +24,12 @@
 #include <pybind11/functional.h>
 #include <pybind11/stl.h>
 #include <functional>
+#include <limits>
 #include <cmath>
 #include <stdexcept>
 #include <fwdpp/diploid.hh>
 #include <fwdpp/simparams.hpp>
+#include <fwdpp/internal/sample_diploid_helpers.hpp>
 #include <fwdpy11/rng.hpp>
 #include <fwdpy11/types/DiploidPopulation.hpp>
 #include <fwdpy11/genetic_values/DiploidPopulationGeneticValue.hpp>
@@ -42,11 +44,82 @@
 #include "cleanup_metadata.hpp"
 #include "track_mutation_counts.hpp"
 #include "remove_extinct_mutations.hpp"
+#include "compact_gametes.hpp"
+#include "tree_sequence_evolution_state.hpp"
 
 namespace py = pybind11;
 
+namespace
+{
+    using generation_function = std::function<void(
+        const std::uint32_t, const fwdpp::ts::TS_NODE_INT,
+        const fwdpp::ts::TS_NODE_INT)>;
+
+    template <typename recombination_policy, typename mutation_policy,
+              typename genetic_param_holder, typename pick1_fxn,
+              typename pick2_fxn, typename metadata_fxn>
+    generation_function
+    bind_evolve_generation(
+        const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulation &pop,
+        genetic_param_holder &genetics, const pick1_fxn &pick_first_parent,
+        const pick2_fxn pick_second_parent,
+        const metadata_fxn &generate_offspring_metadata,
+        fwdpy11::dipvector_t &offspring,
+        std::vector<fwdpy11::DiploidMetadata> &offspring_metadata,
+        const std::int64_t max_node_id)
+    {
+        return [&rng, &pop, &genetics, &pick_first_parent, pick_second_parent,
+                &generate_offspring_metadata, &offspring, &offspring_metadata,
+                max_node_id](const std::uint32_t N_next,
+                             const fwdpp::ts::TS_NODE_INT first_parental_index,
+                             const fwdpp::ts::TS_NODE_INT next_index) {
+            fwdpy11::evolve_generation_ts<recombination_policy,
+                                          mutation_policy>(
+                rng, pop, genetics, N_next, pick_first_parent,
+                pick_second_parent, generate_offspring_metadata,
+                pop.generation, pop.tables, first_parental_index, next_index,
+                offspring, offspring_metadata, max_node_id);
+        };
+    }
+
+    template <typename recombination_policy, typename... Args>
+    generation_function
+    dispatch_mutation_policy(const bool mutates, Args &&... args)
+    {
+        if (mutates)
+            {
+                return bind_evolve_generation<
+                    recombination_policy,
+                    fwdpy11::generation_policies::mutation>(
+                    std::forward<Args>(args)...);
+            }
+        return bind_evolve_generation<
+            recombination_policy, fwdpy11::generation_policies::no_mutation>(
+            std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    generation_function
+    wrap_evolve_generation(const bool recombines, const bool mutates,
+                           Args &&... args)
+    // Returns a function that generates the offspring for one generation.
+    // The function is compiled without any calls to generate breakpoints
+    // and/or mutations when the model does not need them.
+    {
+        if (recombines)
+            {
+                return dispatch_mutation_policy<
+                    fwdpy11::generation_policies::recombination>(
+                    mutates, std::forward<Args>(args)...);
+            }
+        return dispatch_mutation_policy<
+            fwdpy11::generation_policies::no_recombination>(
+            mutates, std::forward<Args>(args)...);
+    }
+} // namespace
+
 // TODO: allow for neutral mutations in the future
-void
+bool
 evolve_with_tree_sequences(
     const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulation &pop,
     fwdpy11::SampleRecorder &sr, const unsigned simplification_interval,
@@ -62,9 +135,21 @@ evolve_with_tree_sequences(
     const bool preserve_selected_fixations,
     const bool suppress_edge_table_indexing, bool record_genotype_matrix,
     const bool track_mutation_counts_during_sim,
-    const bool remove_extinct_mutations_at_finish)
+    const bool remove_extinct_mutations_at_finish,
+    const double gamete_compaction_threshold, const unsigned nthreads,
+    TreeSequenceEvolutionState &state, const std::uint32_t max_generations,
+    const bool simplify_on_return)
+// Simulates at most max_generations of the list of population sizes,
+// continuing from where the previous call with the same state left off.
+// The remaining arguments must not change from call to call.
+// Returns true when the simulation is finished, in which case the
+// population has been simplified and its mutations counted.
 {
     //validate the input params
+    if (state.finished)
+        {
+            throw std::invalid_argument("simulation has already finished");
+        }
     if (pop.tables.genome_length() == std::numeric_limits<double>::max())
         {
             throw std::invalid_argument(
@@ -86,15 +171,33 @@ evolve_with_tree_sequences(
         {
             throw std::invalid_argument("empty list of population sizes");
         }
+    if (!max_generations)
+        {
+            throw std::invalid_argument(
+                "number of generations to simulate must be positive");
+        }
     if (pop.tables.node_table.empty())
         {
             throw std::invalid_argument("node table is not initialized");
         }
+    if (!std::isfinite(gamete_compaction_threshold)
+        || gamete_compaction_threshold < 0.0
+        || gamete_compaction_threshold > 1.0)
+        {
+            throw std::invalid_argument(
+                "gamete compaction threshold must be in [0, 1]");
+        }
 
     const auto bound_mmodel = [&rng, &mmodel, &pop, mu_selected](
                                   fwdpp::flagged_mutation_queue &recycling_bin,
                                   std::vector<fwdpy11::Mutation> &mutations) {
         std::vector<fwdpp::uint_t> rv;
+        if (mu_selected == 0.0)
+            {
+                // Like the loop specialized for no mutation,
+                // make no random draw.
+                return rv;
+            }
         unsigned nmuts = gsl_ran_poisson(rng.get(), mu_selected);
         for (unsigned i = 0; i < nmuts; ++i)
             {
@@ -116,25 +219,64 @@ evolve_with_tree_sequences(
 
     auto genetics = fwdpp::make_genetic_parameters(
         std::ref(genetic_value_fxn), std::move(bound_mmodel), std::move(bound_rmodel));
-    // A stateful fitness model will need its data up-to-date,
-    // so we must call update(...) prior to calculating fitness,
-    // else bad stuff like segfaults could happen.
-    genetic_value_fxn.update(pop);
-    std::vector<fwdpy11::DiploidMetadata> new_metadata(pop.N);
-    std::vector<double> new_diploid_gvalues;
     auto calculate_fitness
-        = wrap_calculate_fitness_DiploidPopulation(record_genotype_matrix);
-    auto lookup = calculate_fitness(rng, pop, genetic_value_fxn, new_metadata,
-                                    new_diploid_gvalues);
+        = wrap_calculate_fitness_DiploidPopulation(record_genotype_matrix,
+                                                   nthreads);
+    // Haploid effect caches are not maintained by evolve_generation_ts,
+    // so genetic values must be calculated from the mutations of the
+    // current gametes.
+    auto haploid_cache = genetic_value_fxn.tracked_haploid_cache();
+    if (haploid_cache != nullptr)
+        {
+            haploid_cache->invalidate();
+        }
+    if (!state.initialized)
+        {
+            // A stateful fitness model will need its data up-to-date,
+            // so we must call update(...) prior to calculating fitness,
+            // else bad stuff like segfaults could happen.
+            genetic_value_fxn.update(pop);
+            state.new_metadata.resize(pop.N);
+            calculate_fitness(rng, pop, genetic_value_fxn,
+                              state.new_metadata, state.new_diploid_gvalues,
+                              state.lookup);
+            state.next_index = pop.tables.node_table.size();
+            state.simplifier.reset(
+                new fwdpp::ts::table_simplifier(pop.tables.genome_length()));
+            state.initialized = true;
+        }
+    else
+        {
+            // Resume with the recycling bin from the previous call
+            genetics.mutation_recycling_bin
+                = std::move(state.mutation_recycling_bin);
+        }
+    auto &lookup = state.lookup;
+    auto &simplifier = *state.simplifier;
+    auto &first_parental_index = state.first_parental_index;
+    auto &next_index = state.next_index;
+    auto &simplified = state.simplified;
 
     // Generate our fxns for picking parents
 
     // Because lambdas that capture by reference do a "late" binding of
     // params, this is safe w.r.to updating lookup after each generation.
     const auto pick_first_parent = [&rng, &lookup]() {
-        return gsl_ran_discrete(rng.get(), lookup.get());
+        return lookup(rng);
     };
 
+    // The three cases of selfing are handled by separate
+    // functions so that the outcrossing and fully-selfing
+    // cases have no per-offspring branching.
+    const auto pick_second_parent_outcrossing
+        = [&rng, &lookup](const std::size_t /*p1*/) {
+              return lookup(rng);
+          };
+    const auto pick_second_parent_selfing
+        = [](const std::size_t p1) { return p1; };
+    // Rates of 0 and 1 make no random draw here, so that
+    // this function picks the same parents as the
+    // specialized ones for a given seed.
     const auto pick_second_parent
         = [&rng, &lookup, selfing_rate](const std::size_t p1) {
               if (selfing_rate == 1.0
@@ -143,7 +285,7 @@ evolve_with_tree_sequences(
                   {
                       return p1;
                   }
-              return gsl_ran_discrete(rng.get(), lookup.get());
+              return lookup(rng);
           };
     const auto generate_offspring_metadata
         = [](fwdpy11::DiploidMetadata &offspring_metadata,
@@ -164,34 +306,70 @@ evolve_with_tree_sequences(
                 pop.mcounts, pop.mcounts_from_preserved_nodes);
         }
 
-    fwdpp::ts::TS_NODE_INT first_parental_index = 0,
-                           next_index = pop.tables.node_table.size();
-    bool simplified = false;
-    fwdpp::ts::table_simplifier simplifier(pop.tables.genome_length());
+    // The generic loop gives the same output as the specialized
+    // ones, and is only forced by tests that check this.
+    const bool generic = state.generic_generation_loop;
+    const bool recombines = generic || !rmodel.zero_recombination();
+    const bool mutates = generic || mu_selected > 0.0;
+    generation_function evolve_generation;
+    if (!generic && selfing_rate == 0.0)
+        {
+            evolve_generation = wrap_evolve_generation(
+                recombines, mutates, rng, pop, genetics, pick_first_parent,
+                pick_second_parent_outcrossing, generate_offspring_metadata,
+                state.offspring, state.offspring_metadata,
+                state.max_node_id);
+        }
+    else if (!generic && selfing_rate == 1.0)
+        {
+            evolve_generation = wrap_evolve_generation(
+                recombines, mutates, rng, pop, genetics, pick_first_parent,
+                pick_second_parent_selfing, generate_offspring_metadata,
+                state.offspring, state.offspring_metadata,
+                state.max_node_id);
+        }
+    else
+        {
+            evolve_generation = wrap_evolve_generation(
+                recombines, mutates, rng, pop, genetics, pick_first_parent,
+                pick_second_parent, generate_offspring_metadata,
+                state.offspring, state.offspring_metadata,
+                state.max_node_id);
+        }
+
     bool stopping_criteron_met = false;
-    for (std::uint32_t gen = 0;
-         gen < num_generations && !stopping_criteron_met; ++gen)
+    const std::uint32_t last_generation
+        = (max_generations < num_generations - state.generations_completed)
+              ? state.generations_completed + max_generations
+              : num_generations;
+    for (std::uint32_t gen = state.generations_completed;
+         gen < last_generation && !stopping_criteron_met; ++gen)
         {
             ++pop.generation;
             const auto N_next = popsizes.at(gen);
-            // TODO: can simplify function further b/c we are referring
-            // to data that fwdpy11 Populations contain.
-            fwdpy11::evolve_generation_ts(
-                rng, pop, genetics, N_next, pick_first_parent,
-                pick_second_parent, generate_offspring_metadata,
-                pop.generation, pop.tables, first_parental_index, next_index);
-
-            //N_next, mu_selected, pick_first_parent,
-            //pick_second_parent, generate_offspring_metadata, bound_mmodel,
-            //mutation_recycling_bin, bound_rmodel, pop.generation,
-            //first_parental_index, next_index);
+            evolve_generation(N_next, first_parental_index, next_index);
 
             pop.N = N_next;
             // TODO: deal with random effects
             genetic_value_fxn.update(pop);
-            lookup = calculate_fitness(rng, pop, genetic_value_fxn,
-                                       new_metadata, new_diploid_gvalues);
-            if (gen > 0 && gen % simplification_interval == 0.0)
+            calculate_fitness(rng, pop, genetic_value_fxn,
+                              state.new_metadata, state.new_diploid_gvalues,
+                              lookup);
+            // Simplify early if the next generation's nodes
+            // would overflow the range of node IDs.
+            const bool node_table_full
+                = gen + 1 < num_generations
+                  && !fwdpy11::node_table_has_capacity(
+                         pop.tables.num_nodes(),
+                         2 * std::int64_t(popsizes.at(gen + 1)),
+                         state.max_node_id);
+            // Simplify when pausing, if requested, so that
+            // the caller sees a simplified population.
+            const bool pausing = simplify_on_return
+                                 && gen + 1 == last_generation
+                                 && last_generation < num_generations;
+            if ((gen > 0 && gen % simplification_interval == 0.0)
+                || node_table_full || pausing)
                 {
                     // TODO: update this to allow neutral mutations to be simulated
                     auto rv = fwdpy11::simplify_tables(
@@ -221,6 +399,10 @@ evolve_with_tree_sequences(
                     first_parental_index = next_index;
                     next_index += 2 * pop.N;
                 }
+            if (gamete_compaction_threshold > 0.0)
+                {
+                    compact_gametes(pop, gamete_compaction_threshold);
+                }
             if (track_mutation_counts_during_sim)
                 {
                     track_mutation_counts(pop, simplified,
@@ -268,8 +450,27 @@ evolve_with_tree_sequences(
                     sr.samples.clear();
                 }
             stopping_criteron_met = stopping_criteron(pop, simplified);
+            ++state.generations_completed;
         }
 
+    if (!stopping_criteron_met
+        && state.generations_completed < num_generations)
+        {
+            // Pause, keeping the state for the next call.
+            // Without simplification, mcounts were last filled in
+            // when the tables were simplified, so count the
+            // mutations in the current gametes instead.
+            if (!simplified && !track_mutation_counts_during_sim)
+                {
+                    fwdpp::fwdpp_internal::process_gametes(
+                        pop.gametes, pop.mutations, pop.mcounts);
+                }
+            state.mutation_recycling_bin
+                = std::move(genetics.mutation_recycling_bin);
+            return false;
+        }
+    state.finished = true;
+
     // NOTE: if tables.preserved_nodes overlaps with samples,
     // then simplification throws an error. But, since it is annoying
     // for a user to have to remember not to do that, we filter the list
@@ -301,10 +502,36 @@ evolve_with_tree_sequences(
         {
             remove_extinct_mutations(pop);
         }
+    return true;
 }
 
 void
 init_evolve_with_tree_sequences(py::module &m)
 {
+    py::class_<TreeSequenceEvolutionState>(m, "_TreeSequenceEvolutionState")
+        .def(py::init<>())
+        .def_property(
+            "_max_node_id",
+            [](const TreeSequenceEvolutionState &state) {
+                return state.max_node_id;
+            },
+            [](TreeSequenceEvolutionState &state, const std::int64_t value) {
+                if (value < 0
+                    || value > std::numeric_limits<
+                                   fwdpp::ts::TS_NODE_INT>::max())
+                    {
+                        throw std::invalid_argument(
+                            "max_node_id must be a valid node ID");
+                    }
+                state.max_node_id = value;
+            },
+            "The largest node ID that may be assigned. "
+            "For testing only.")
+        .def_readwrite("_generic_generation_loop",
+                       &TreeSequenceEvolutionState::generic_generation_loop,
+                       "If True, do not use the generation loops "
+                       "specialized for no recombination, no mutation, "
+                       "or a selfing rate of 0 or 1. For testing only.");
+
     m.def("evolve_with_tree_sequences", &evolve_with_tree_sequences);
 }
@@ -1,8 +1,12 @@
 #include <cmath>
+#include <vector>
+#include <iterator>
+#include <algorithm>
 #include <stdexcept>
 #include <fwdpp/sugar/change_neutral.hpp>
 #include <fwdpy11/types/Population.hpp>
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 
 namespace py = pybind11;
 
@@ -16,6 +20,84 @@ namespace
                 throw std::invalid_argument(error);
             }
     }
+
+    std::vector<std::vector<double>>
+    rows_to_vectors(py::object input, const std::size_t nrows,
+                    const std::string& name)
+    // None means that the vectors are cleared, as for the
+    // default arguments of change_effect_size.
+    {
+        std::vector<std::vector<double>> rv(nrows);
+        if (input.is_none())
+            {
+                return rv;
+            }
+        auto a = input.cast<py::array_t<double>>();
+        if (a.ndim() != 2 || static_cast<std::size_t>(a.shape(0)) != nrows)
+            {
+                throw std::invalid_argument(
+                    name + " must be a 2d array with one row per mutation");
+            }
+        auto r = a.unchecked<2>();
+        for (std::size_t i = 0; i < nrows; ++i)
+            {
+                for (py::ssize_t j = 0; j < r.shape(1); ++j)
+                    {
+                        check_finite(r(i, j), "value in " + name
+                                                  + " is not finite");
+                        rv[i].push_back(r(i, j));
+                    }
+            }
+        return rv;
+    }
+
+    void
+    move_flipped_mutations(fwdpy11::Population& pop,
+                           const std::vector<char>& flipped)
+    // Single pass over the gametes, doing what
+    // fwdpp::change_neutral does for one mutation at a time.
+    // Keys that move between the neutral and selected containers
+    // are merged in by position, after any keys with equal position.
+    {
+        std::vector<fwdpp::uint_t> kept_neutral, kept_selected, to_neutral,
+            to_selected;
+        const auto is_flipped
+            = [&flipped](fwdpp::uint_t k) { return flipped[k] != 0; };
+        const auto by_position = [&pop](fwdpp::uint_t a, fwdpp::uint_t b) {
+            return pop.mutations[a].pos < pop.mutations[b].pos;
+        };
+        for (auto& g : pop.gametes)
+            {
+                if (!g.n
+                    || (std::none_of(begin(g.mutations), end(g.mutations),
+                                     is_flipped)
+                        && std::none_of(begin(g.smutations),
+                                        end(g.smutations), is_flipped)))
+                    {
+                        continue;
+                    }
+                kept_neutral.clear();
+                kept_selected.clear();
+                to_neutral.clear();
+                to_selected.clear();
+                for (auto k : g.mutations)
+                    {
+                        (flipped[k] ? to_selected : kept_neutral).push_back(k);
+                    }
+                for (auto k : g.smutations)
+                    {
+                        (flipped[k] ? to_neutral : kept_selected).push_back(k);
+                    }
+                g.mutations.clear();
+                std::merge(begin(kept_neutral), end(kept_neutral),
+                           begin(to_neutral), end(to_neutral),
+                           std::back_inserter(g.mutations), by_position);
+                g.smutations.clear();
+                std::merge(begin(kept_selected), end(kept_selected),
+                           begin(to_selected), end(to_selected),
+                           std::back_inserter(g.smutations), by_position);
+            }
+    }
 } // namespace
 
 void
@@ -65,6 +147,7 @@ init_change_effect_size(py::module& m)
               pop.mutations[index].h = new_dominance;
               pop.mutations[index].esizes.swap(esizes);
               pop.mutations[index].heffects.swap(heffects);
+              ++pop.effect_size_changes;
               // Update the storage of the mutation,
               // which requires a call into fwdpp
               if (need_to_update_storage)
@@ -95,4 +178,96 @@ init_change_effect_size(py::module& m)
 
             Modified to act on base class and handle vectors of effect sizes. Default values also updated.
         )delim");
+
+    m.def(
+        "change_effect_sizes",
+        [](fwdpy11::Population& pop, py::array_t<std::size_t> indexes,
+           py::array_t<double> new_esizes, py::array_t<double> new_dominance,
+           py::object new_vector_esizes, py::object new_heffects) {
+            auto keys = indexes.unchecked<1>();
+            auto s = new_esizes.unchecked<1>();
+            auto h = new_dominance.unchecked<1>();
+            const auto n = static_cast<std::size_t>(keys.shape(0));
+            if (static_cast<std::size_t>(s.shape(0)) != n
+                || static_cast<std::size_t>(h.shape(0)) != n)
+                {
+                    throw std::invalid_argument(
+                        "indexes, new_esizes, and new_dominance must have "
+                        "the same length");
+                }
+            // Validate everything before modifying the population
+            std::vector<char> changed(pop.mutations.size(), 0);
+            for (std::size_t i = 0; i < n; ++i)
+                {
+                    if (keys(i) >= pop.mutations.size())
+                        {
+                            throw std::range_error(
+                                "mutation index out of range");
+                        }
+                    if (changed[keys(i)])
+                        {
+                            throw std::invalid_argument(
+                                "mutation indexes must be unique");
+                        }
+                    changed[keys(i)] = 1;
+                    check_finite(s(i), "new effect size is not finite");
+                    check_finite(h(i), "new dominance is not finite");
+                }
+            auto esizes = rows_to_vectors(new_vector_esizes, n,
+                                          "new_vector_esizes");
+            auto heffects = rows_to_vectors(new_heffects, n, "new_heffects");
+
+            std::vector<char> flipped(pop.mutations.size(), 0);
+            bool any_flipped = false;
+            for (std::size_t i = 0; i < n; ++i)
+                {
+                    auto& mut = pop.mutations[keys(i)];
+                    bool neutral
+                        = s(i) == 0.0
+                          && std::all_of(begin(esizes[i]), end(esizes[i]),
+                                         [](double d) { return d == 0.0; });
+                    mut.s = s(i);
+                    mut.h = h(i);
+                    mut.esizes.swap(esizes[i]);
+                    mut.heffects.swap(heffects[i]);
+                    if (neutral != mut.neutral)
+                        {
+                            mut.neutral = neutral;
+                            flipped[keys(i)] = 1;
+                            any_flipped = true;
+                        }
+                }
+            if (any_flipped)
+                {
+                    move_flipped_mutations(pop, flipped);
+                }
+            ++pop.effect_size_changes;
+        },
+        py::arg("pop"), py::arg("indexes"), py::arg("new_esizes"),
+        py::arg("new_dominance"), py::arg("new_vector_esizes") = py::none(),
+        py::arg("new_heffects") = py::none(),
+        R"delim(
+        Change effect sizes and/or dominance of many mutations at once.
+
+        The result is the same as calling :func:`fwdpy11.change_effect_size`
+        for each mutation, but mutations that change between neutral and
+        selected are moved in a single pass over the haploid genomes.
+
+        :param pop: A :class:`fwdpy11.Population`
+        :param indexes: The indexes of the mutations to change, which must be unique
+        :type indexes: numpy.ndarray
+        :param new_esizes: The new values for the `s` field
+        :type new_esizes: numpy.ndarray
+        :param new_dominance: The new values for the `h` field
+        :type new_dominance: numpy.ndarray
+        :param new_vector_esizes: (None) 2d array whose rows are the new :attr:`fwdpy11.Mutation.esizes`
+        :type new_vector_esizes: numpy.ndarray
+        :param new_heffects: (None) 2d array whose rows are the new :attr:`fwdpy11.Mutation.heffects`
+        :type new_heffects: numpy.ndarray
+
+        If `new_vector_esizes` or `new_heffects` are None, the
+        corresponding fields are cleared.
+
+        No changes are made if any of the input is invalid.
+        )delim");
 }
@@ -0,0 +1,137 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/genetic_values/MultivariateGSSCovariance.hpp>
+
+namespace py = pybind11;
+
+namespace
+{
+    std::vector<double>
+    covariance_to_vector(py::array_t<double> covariance)
+    {
+        if (covariance.ndim() != 2
+            || covariance.shape(0) != covariance.shape(1))
+            {
+                throw std::invalid_argument(
+                    "covariance matrix must be square");
+            }
+        auto c = covariance.unchecked<2>();
+        std::vector<double> rv;
+        rv.reserve(c.shape(0) * c.shape(1));
+        for (py::ssize_t i = 0; i < c.shape(0); ++i)
+            {
+                for (py::ssize_t j = 0; j < c.shape(1); ++j)
+                    {
+                        rv.push_back(c(i, j));
+                    }
+            }
+        return rv;
+    }
+} // namespace
+
+void
+init_MultivariateGSSCovariance(py::module& m)
+{
+    py::class_<fwdpy11::MultivariateGSSCovariance,
+               fwdpy11::MultivariateGeneticValueToFitnessMap>(
+        m, "MultivariateGSSCovariance",
+        "Multivariate Gaussian stabilizing selection with a selection "
+        "covariance matrix.")
+        .def(py::init([](py::array_t<double> optimum,
+                         py::array_t<double> covariance) {
+                 auto o = optimum.unchecked<1>();
+                 std::vector<double> io;
+                 for (py::ssize_t i = 0; i < o.shape(0); ++i)
+                     {
+                         io.push_back(o(i));
+                     }
+                 return fwdpy11::MultivariateGSSCovariance(
+                     {0}, std::move(io), covariance_to_vector(covariance));
+             }),
+             py::arg("optimum"), py::arg("covariance"),
+             R"delim(
+        :param optimum: The optimal trait values
+        :type optimum: numpy.array
+        :param covariance: The selection covariance matrix
+        :type covariance: numpy.ndarray
+
+        Fitness is :math:`w = e^{-(z-\theta)^T S^{-1}(z-\theta)/2}`,
+        where :math:`S` is the covariance matrix, which must be symmetric
+        and positive-definite.  When :math:`S = V_S I`, this model is
+        the same as :class:`fwdpy11.MultivariateGSS`.
+        )delim")
+        .def(py::init([](py::array_t<std::uint32_t> timepoints,
+                         py::array_t<double> optima,
+                         py::array_t<double> covariance) {
+                 auto t = timepoints.unchecked<1>();
+                 auto o = optima.unchecked<2>();
+                 std::vector<std::uint32_t> it(t.data(0),
+                                               t.data(0) + t.shape(0));
+                 std::vector<double> io;
+                 for (py::ssize_t i = 0; i < o.shape(0); ++i)
+                     {
+                         for (py::ssize_t j = 0; j < o.shape(1); ++j)
+                             {
+                                 io.push_back(o(i, j));
+                             }
+                     }
+                 return fwdpy11::MultivariateGSSCovariance(
+                     std::move(it), std::move(io),
+                     covariance_to_vector(covariance));
+             }),
+             py::arg("timepoints"), py::arg("optima"), py::arg("covariance"),
+             R"delim(
+        :param timepoints: Time when the optima change
+        :type timepoints: numpy.array
+        :param optima: The optima corresponding to each time point
+        :type optima: numpy.ndarray
+        :param covariance: The selection covariance matrix
+        :type covariance: numpy.ndarray
+
+        The rows of optima are the optimal trait values at each time point,
+        as for :class:`fwdpy11.MultivariateGSSmo`.  The covariance matrix
+        does not change over time.
+        )delim")
+        .def_property_readonly(
+            "covariance",
+            [](const fwdpy11::MultivariateGSSCovariance& self) {
+                py::array_t<double> rv({ self.ndim, self.ndim });
+                std::copy(begin(self.covariance), end(self.covariance),
+                          rv.mutable_data());
+                return rv;
+            },
+            "The selection covariance matrix.")
+        .def(py::pickle(
+            [](const fwdpy11::MultivariateGSSCovariance& self) {
+                return self.pickle();
+            },
+            [](py::object o) {
+                auto t = o.cast<py::tuple>();
+                auto l = t[0].cast<py::list>();
+                std::vector<std::uint32_t> tp;
+                for (auto i : l)
+                    {
+                        tp.push_back(i.cast<std::uint32_t>());
+                    }
+                l = t[1].cast<py::list>();
+                std::vector<double> optima;
+                for (auto i : l)
+                    {
+                        optima.push_back(i.cast<double>());
+                    }
+                l = t[2].cast<py::list>();
+                std::vector<double> covariance;
+                for (auto i : l)
+                    {
+                        covariance.push_back(i.cast<double>());
+                    }
+                return fwdpy11::MultivariateGSSCovariance(
+                    std::move(tp), std::move(optima), std::move(covariance));
+            }))
+        .def("__eq__", [](const fwdpy11::MultivariateGSSCovariance& lhs,
+                          const fwdpy11::MultivariateGSSCovariance& rhs) {
+            return lhs.timepoints == rhs.timepoints && lhs.optima == rhs.optima
+                   && lhs.covariance == rhs.covariance;
+        });
+}
@@ -12,6 +12,7 @@ void init_GSSmo(py::module&);
 void init_MultivariateGeneticValueToFitnessMap(py::module&);
 void init_MultivariateGSS(py::module&);
 void init_MultivariateGSSmo(py::module&);
+void init_MultivariateGSSCovariance(py::module&);
 
 void
 initialize_genetic_value_to_fitness(py::module& m)
@@ -25,4 +26,5 @@ initialize_genetic_value_to_fitness(py::module& m)
     init_MultivariateGeneticValueToFitnessMap(m);
     init_MultivariateGSS(m);
     init_MultivariateGSSmo(m);
+    init_MultivariateGSSCovariance(m);
 }
@@ -77,6 +77,12 @@ init_Additive(py::module& m)
             },
             "Returns True if instance calculates fitness as the genetic value "
             "and False if the genetic value is a trait value.")
+        .def_readwrite(
+            "cache_haploid_effects",
+            &fwdpy11::DiploidAdditive::cache_haploid_effects,
+            "If True, genetic values are obtained from per-gamete "
+            "summaries of effect sizes when possible. Defaults to False. "
+            "This setting is not pickled.")
         .def(py::pickle(
             [](const fwdpy11::DiploidAdditive& a) {
                 auto p = py::module::import("pickle");
@@ -0,0 +1,165 @@
+#include <fwdpy11/genetic_values/DiploidPopulationBatchGeneticValue.hpp>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+namespace py = pybind11;
+
+namespace
+{
+    class PyBatchGeneticValue
+        : public fwdpy11::DiploidPopulationBatchGeneticValue
+    // Allows batch_gvalues to be overridden in Python
+    {
+      public:
+        using fwdpy11::DiploidPopulationBatchGeneticValue::
+            DiploidPopulationBatchGeneticValue;
+
+        py::array_t<double>
+        batch_gvalues(const fwdpy11::BatchGeneticValueData& data) const override
+        {
+            py::gil_scoped_acquire gil;
+            py::function overload = py::get_overload(
+                static_cast<const fwdpy11::DiploidPopulationBatchGeneticValue*>(
+                    this),
+                "batch_gvalues");
+            if (!overload)
+                {
+                    throw std::runtime_error("batch_gvalues not implemented");
+                }
+            // Passing a pointer means that data are not copied
+            return overload(&data).cast<py::array_t<double>>();
+        }
+    };
+
+    const fwdpy11::BatchGeneticValueData&
+    valid_data(const py::object& self)
+    {
+        const auto& data = self.cast<const fwdpy11::BatchGeneticValueData&>();
+        if (data.pop == nullptr)
+            {
+                throw std::runtime_error(
+                    "data are only valid during a call to batch_gvalues");
+            }
+        return data;
+    }
+
+    template <typename T>
+    py::array_t<T>
+    readonly_view(std::vector<py::ssize_t> shape,
+                  std::vector<py::ssize_t> strides, const T* data,
+                  const py::object& base)
+    // A readonly numpy array that refers to data owned by C++
+    {
+        py::array_t<T> rv(std::move(shape), std::move(strides), data, base);
+        rv.attr("flags").attr("writeable") = false;
+        return rv;
+    }
+} // namespace
+
+void
+init_BatchGeneticValue(py::module& m)
+{
+    py::class_<fwdpy11::BatchGeneticValueData>(
+        m, "BatchGeneticValueData",
+        R"delim(
+        Data passed to :func:`fwdpy11.BatchGeneticValue.batch_gvalues`.
+
+        All arrays are readonly views of data owned by the simulation
+        and are only valid during that call.  The population itself
+        is not exposed, because a reference to it could outlive the
+        call.  Accessing any attribute after the call has returned
+        raises ``RuntimeError``.
+
+        .. versionadded:: 0.5.0
+        )delim")
+        .def_property_readonly(
+            "diploids",
+            [](py::object self) {
+                const auto& d = valid_data(self);
+                const auto& dips = d.pop->diploids;
+                return readonly_view<std::size_t>(
+                    { static_cast<py::ssize_t>(dips.size()), 2 },
+                    { sizeof(fwdpy11::DiploidGenotype), sizeof(std::size_t) },
+                    dips.empty() ? nullptr : &dips.data()->first, self);
+            },
+            "2d array of the gamete indexes of each diploid.")
+        .def_property_readonly(
+            "parents",
+            [](py::object self) {
+                const auto& d = valid_data(self);
+                const auto& md = *d.metadata;
+                return readonly_view<std::size_t>(
+                    { static_cast<py::ssize_t>(d.pop->diploids.size()), 2 },
+                    { sizeof(fwdpy11::DiploidMetadata), sizeof(std::size_t) },
+                    md.empty() ? nullptr : &md.data()->parents[0], self);
+            },
+            "2d array of the parent indexes of each diploid.")
+        .def_property_readonly(
+            "keys",
+            [](py::object self) {
+                const auto& d = valid_data(self);
+                return readonly_view<fwdpp::uint_t>(
+                    { static_cast<py::ssize_t>(d.keys.size()) },
+                    { sizeof(fwdpp::uint_t) }, d.keys.data(), self);
+            },
+            "The selected mutation keys of all gametes.")
+        .def_property_readonly(
+            "offsets",
+            [](py::object self) {
+                const auto& d = valid_data(self);
+                return readonly_view<std::size_t>(
+                    { static_cast<py::ssize_t>(d.offsets.size()) },
+                    { sizeof(std::size_t) }, d.offsets.data(), self);
+            },
+            "The keys of gamete i are keys[offsets[i]:offsets[i+1]].")
+        .def_property_readonly(
+            "s",
+            [](py::object self) {
+                const auto& d = valid_data(self);
+                const auto& mutations = d.pop->mutations;
+                return readonly_view<double>(
+                    { static_cast<py::ssize_t>(mutations.size()) },
+                    { sizeof(fwdpy11::Mutation) },
+                    mutations.empty() ? nullptr : &mutations.data()->s, self);
+            },
+            "Effect sizes of all mutations, indexed by key.")
+        .def_property_readonly(
+            "h",
+            [](py::object self) {
+                const auto& d = valid_data(self);
+                const auto& mutations = d.pop->mutations;
+                return readonly_view<double>(
+                    { static_cast<py::ssize_t>(mutations.size()) },
+                    { sizeof(fwdpy11::Mutation) },
+                    mutations.empty() ? nullptr : &mutations.data()->h, self);
+            },
+            "Dominance of all mutations, indexed by key.")
+        .def_property_readonly(
+            "generation",
+            [](py::object self) { return valid_data(self).pop->generation; },
+            "The generation of the parents.");
+
+    py::class_<fwdpy11::DiploidPopulationBatchGeneticValue, PyBatchGeneticValue,
+               fwdpy11::DiploidPopulationGeneticValueWithMapping>(
+        m, "BatchGeneticValue",
+        R"delim(
+        ABC for genetic value models implemented in Python.
+
+        Subclasses must call the base class constructor
+        and define batch_gvalues(self, data), where data
+        is a :class:`fwdpy11.BatchGeneticValueData`.
+        It must return an array containing the genetic value
+        of each diploid, which is called once per generation.
+
+        Instances cannot be pickled, and cannot be called to
+        evaluate a single individual.  The genetic values are
+        stored in :attr:`fwdpy11.DiploidPopulation.diploid_metadata`.
+
+        .. versionadded:: 0.5.0
+        )delim")
+        .def(py::init<const fwdpy11::GeneticValueToFitnessMap&>(),
+             py::arg("gv2w"))
+        .def(py::init<const fwdpy11::GeneticValueToFitnessMap&,
+                      const fwdpy11::GeneticValueNoise&>(),
+             py::arg("gv2w"), py::arg("noise"));
+}
@@ -45,6 +45,12 @@ init_GBR(py::module& m)
                  return fwdpy11::DiploidGBR(fwdpy11::GBR{}, gv2w, noise);
              }),
              py::arg("gv2w"), py::arg("noise"), GBR_CONSTRUCTOR2)
+        .def_readwrite(
+            "cache_haploid_effects",
+            &fwdpy11::DiploidGBR::cache_haploid_effects,
+            "If True, genetic values are obtained from per-gamete "
+            "summaries of effect sizes when possible. Defaults to False. "
+            "This setting is not pickled.")
         .def(py::pickle(
             [](const fwdpy11::DiploidGBR& g) {
                 auto p = py::module::import("pickle");
@@ -0,0 +1,134 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/genetic_values/DiploidPairwiseEpistasis.hpp>
+
+namespace py = pybind11;
+
+namespace
+{
+    using interaction_list
+        = std::vector<fwdpy11::epistatic_interaction_index::interaction>;
+
+    static const auto PAIRWISE_EPISTASIS_CONSTRUCTOR_1 =
+        R"delim(
+Additive effects plus pairwise epistasis on fitness.
+
+:param scaling: How to treat mutant homozygotes.
+:type scaling: float
+:param interactions: Interacting labels and the effect of each interaction
+:type interactions: list of tuples (label, label, effect)
+
+Fitness is max(0, 1 + g), where g is the genetic value.
+)delim";
+
+    static const auto PAIRWISE_EPISTASIS_CONSTRUCTOR_2 =
+        R"delim(
+Additive effects plus pairwise epistasis on a trait.
+
+:param scaling: How to treat mutant homozygotes.
+:type scaling: float
+:param interactions: Interacting labels and the effect of each interaction
+:type interactions: list of tuples (label, label, effect)
+:param gv2w: Map from genetic value to fitness.
+:type gv2w: :class:`fwdpy11.GeneticValueIsTrait`
+)delim";
+
+    static const auto PAIRWISE_EPISTASIS_CONSTRUCTOR_3 =
+        R"delim(
+Additive effects plus pairwise epistasis on a trait,
+with random effects ("noise").
+
+:param scaling: How to treat mutant homozygotes.
+:type scaling: float
+:param interactions: Interacting labels and the effect of each interaction
+:type interactions: list of tuples (label, label, effect)
+:param gv2w: Map from genetic value to fitness.
+:type gv2w: :class:`fwdpy11.GeneticValueIsTrait`
+:param noise: Function to generate random effects on trait value.
+:type noise: :class:`fwdpy11.GeneticValueNoise`
+)delim";
+} // namespace
+
+void
+init_PairwiseEpistasis(py::module& m)
+{
+    py::class_<fwdpy11::DiploidPairwiseEpistasis,
+               fwdpy11::DiploidPopulationGeneticValueWithMapping>(
+        m, "PairwiseEpistasis",
+        R"delim(
+        Additive genetic values plus pairwise epistasis.
+
+        Interactions are between mutation labels, which are
+        assigned to new mutations by the ``label`` of their
+        :class:`fwdpy11.Sregion`.  For interacting labels a and b,
+        the genetic value of a diploid is increased by e*c_a*c_b,
+        where e is the effect of the interaction and c_a is the
+        number of copies of selected mutations with label a that
+        the diploid carries.  Label 0 cannot interact.
+
+        The effect of each pair of labels is fixed when the object is
+        created.  Effects are not drawn for each new mutation, so
+        mutations that should interact differently must be given
+        different labels, for example by using several
+        :class:`fwdpy11.Sregion` objects.
+
+        .. versionadded:: 0.5.0
+        )delim")
+        .def(py::init<double, interaction_list>(), py::arg("scaling"),
+             py::arg("interactions"), PAIRWISE_EPISTASIS_CONSTRUCTOR_1)
+        .def(py::init<double, interaction_list,
+                      const fwdpy11::GeneticValueIsTrait&>(),
+             py::arg("scaling"), py::arg("interactions"), py::arg("gv2w"),
+             PAIRWISE_EPISTASIS_CONSTRUCTOR_2)
+        .def(py::init<double, interaction_list,
+                      const fwdpy11::GeneticValueIsTrait&,
+                      const fwdpy11::GeneticValueNoise&>(),
+             py::arg("scaling"), py::arg("interactions"), py::arg("gv2w"),
+             py::arg("noise"), PAIRWISE_EPISTASIS_CONSTRUCTOR_3)
+        .def_property_readonly(
+            "scaling",
+            [](const fwdpy11::DiploidPairwiseEpistasis& self) {
+                return self.additive.scaling;
+            },
+            "Access to the scaling parameter.")
+        .def_readonly("is_fitness",
+                      &fwdpy11::DiploidPairwiseEpistasis::is_fitness,
+                      "Returns True if instance calculates fitness as the "
+                      "genetic value and False if the genetic value is a "
+                      "trait value.")
+        .def_property_readonly(
+            "interactions",
+            [](const fwdpy11::DiploidPairwiseEpistasis& self) {
+                return self.index.interactions();
+            },
+            "List of interactions, with the smaller label first.")
+        .def(py::pickle(
+            [](const fwdpy11::DiploidPairwiseEpistasis& self) {
+                auto p = py::module::import("pickle");
+                return py::make_tuple(
+                    self.pickle(), p.attr("dumps")(self.gv2w->clone(), -1),
+                    p.attr("dumps")(self.noise_fxn->clone(), -1));
+            },
+            [](py::tuple t) {
+                if (t.size() != 3)
+                    {
+                        throw std::runtime_error("invalid tuple size");
+                    }
+                auto data = t[0].cast<py::tuple>();
+                auto scaling = data[0].cast<double>();
+                auto is_fitness = data[1].cast<bool>();
+                auto interactions = data[2].cast<interaction_list>();
+                if (is_fitness)
+                    {
+                        return fwdpy11::DiploidPairwiseEpistasis(
+                            scaling, std::move(interactions));
+                    }
+                auto p = py::module::import("pickle");
+                auto gv2w = p.attr("loads")(t[1]);
+                auto noise = p.attr("loads")(t[2]);
+                return fwdpy11::DiploidPairwiseEpistasis(
+                    scaling, std::move(interactions),
+                    gv2w.cast<const fwdpy11::GeneticValueToFitnessMap&>(),
+                    noise.cast<const fwdpy11::GeneticValueNoise&>());
+            }));
+}
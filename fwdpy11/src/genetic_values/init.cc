@@ -9,6 +9,8 @@ void init_Multiplicative(py::module&);
 void init_GBR(py::module&);
 void init_DiploidPopulationMultivariateGeneticValueWithMapping(py::module&);
 void init_DiploidMultivariateEffectsStrictAdditive(py::module&);
+void init_BatchGeneticValue(py::module&);
+void init_PairwiseEpistasis(py::module&);
 
 void
 init_base_classes(py::module& m)
@@ -16,6 +18,7 @@ init_base_classes(py::module& m)
     init_GeneticValue(m);
     init_GeneticValueWithMapping(m);
     init_DiploidPopulationMultivariateGeneticValueWithMapping(m);
+    init_BatchGeneticValue(m);
 }
 
 void
@@ -25,6 +28,7 @@ init_genetic_value_classes(py::module& m)
     init_Multiplicative(m);
     init_GBR(m);
     init_DiploidMultivariateEffectsStrictAdditive(m);
+    init_PairwiseEpistasis(m);
 }
 
 void
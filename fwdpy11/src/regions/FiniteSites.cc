@@ -0,0 +1,75 @@
+#include <pybind11/pybind11.h>
+#include <fwdpy11/regions/FiniteSites.hpp>
+#include <fwdpy11/regions/ConstantS.hpp>
+
+namespace py = pybind11;
+
+void
+init_FiniteSites(py::module& m)
+{
+    py::class_<fwdpy11::FiniteSites, fwdpy11::Sregion>(
+        m, "FiniteSites",
+        R"delim(
+        Mutations at integer sites.
+
+        The bounds of the region are in base pairs, and new mutations
+        are placed at the integer positions `beg`, `beg + 1`, ...,
+        `end - 1`.  Effect sizes, dominance, weight, and label are
+        those of the wrapped :class:`fwdpy11.Sregion`.
+
+        By default, a new mutation occurs at a site chosen uniformly among
+        those not occupied by a segregating (or retained fixed) mutation.
+        The occupied sites are tracked by a bitmap, so this choice does
+        not slow down as the region fills up.  It is an error to mutate
+        a region whose sites are all occupied.
+
+        If `recurrent` is True, any site may mutate, and a site may
+        therefore carry more than one mutation.  Recurrent mutation is only
+        supported by :func:`fwdpy11.evolve_genomes`.
+
+        Neutral sites, such as those of `FiniteSites(region)`, may be
+        used in :attr:`fwdpy11.ModelParams.nregions` along with
+        :class:`fwdpy11.Region` objects.
+        )delim")
+        .def(py::init([](const fwdpy11::Sregion& dfe, bool recurrent) {
+                 return fwdpy11::FiniteSites(dfe.clone(), recurrent);
+             }),
+             py::arg("dfe"), py::arg("recurrent") = false,
+             R"delim(
+        :param dfe: The region and distribution of effect sizes
+        :type dfe: :class:`fwdpy11.Sregion`
+        :param recurrent: (False) Allow mutation at occupied sites
+        :type recurrent: bool
+
+        :raises ValueError: if `dfe` is not a distribution of effect
+            sizes, such as :class:`fwdpy11.ExpS`.  A
+            :class:`fwdpy11.FiniteSites` or
+            :class:`fwdpy11.MutationIntervalMap` is not accepted.
+        )delim")
+        .def(py::init([](const fwdpy11::Region& r, bool recurrent) {
+                 return fwdpy11::FiniteSites(
+                     std::unique_ptr<fwdpy11::Sregion>(
+                         new fwdpy11::ConstantS(r, 1.0, 0.0, 0.0)),
+                     recurrent);
+             }),
+             py::arg("region"), py::arg("recurrent") = false,
+             R"delim(
+        Neutral mutations at the sites of a :class:`fwdpy11.Region`.
+
+        :param region: The region
+        :type region: :class:`fwdpy11.Region`
+        :param recurrent: (False) Allow mutation at occupied sites
+        :type recurrent: bool
+        )delim")
+        .def_property_readonly(
+            "dfe",
+            [](const fwdpy11::FiniteSites& self) {
+                return py::cast(self.dfe->clone());
+            },
+            "A copy of the distribution of effect sizes")
+        .def_readonly("recurrent", &fwdpy11::FiniteSites::recurrent)
+        .def("__repr__", &fwdpy11::FiniteSites::repr)
+        .def(py::pickle(
+            [](const fwdpy11::FiniteSites& self) { return self.pickle(); },
+            [](py::tuple t) { return fwdpy11::FiniteSites::unpickle(t); }));
+}
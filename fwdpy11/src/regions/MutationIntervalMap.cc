@@ -0,0 +1,143 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/regions/MutationIntervalMap.hpp>
+
+namespace py = pybind11;
+
+namespace
+{
+    std::vector<std::unique_ptr<fwdpy11::Sregion>>
+    clone_dfe_classes(py::list dfe)
+    {
+        std::vector<std::unique_ptr<fwdpy11::Sregion>> rv;
+        for (auto d : dfe)
+            {
+                rv.emplace_back(d.cast<const fwdpy11::Sregion&>().clone());
+            }
+        return rv;
+    }
+} // namespace
+
+void
+init_MutationIntervalMap(py::module& m)
+{
+    py::class_<fwdpy11::MutationIntervalMap, fwdpy11::Sregion>(
+        m, "MutationIntervalMap",
+        R"delim(
+        Mutation rates and distributions of effect sizes
+        from a set of non-overlapping intervals.
+
+        Each interval has a rate per unit length and a "class",
+        which is an index into a list of :class:`fwdpy11.Sregion`
+        objects.  When this object generates a mutation, an interval
+        is chosen by a binary search of the cumulative weights and
+        the class then generates a mutation uniformly within that interval.
+        Thus, many annotated intervals (exons, conserved elements, etc.)
+        may be described by a single object, and the cost of generating
+        a mutation does not depend on the number of intervals.
+
+        Instances are used as elements of
+        :attr:`fwdpy11.ModelParams.sregions`.  The weight of an instance
+        is the sum of rate times length over all intervals, and the
+        rates are therefore relative to the other elements of
+        `sregions`.
+
+        The positions and weights of the classes are ignored, but
+        their labels are applied to new mutations.
+        )delim")
+        .def(py::init([](const std::vector<double>& starts,
+                         const std::vector<double>& stops,
+                         const std::vector<double>& rates,
+                         const std::vector<std::size_t>& classes,
+                         py::list dfe) {
+                 return fwdpy11::MutationIntervalMap(
+                     starts, stops, rates, classes, clone_dfe_classes(dfe));
+             }),
+             py::arg("starts"), py::arg("stops"), py::arg("rates"),
+             py::arg("classes"), py::arg("dfe"),
+             R"delim(
+        :param starts: Start position of each interval
+        :type starts: list
+        :param stops: End position of each interval
+        :type stops: list
+        :param rates: Rate per unit length of each interval
+        :type rates: list
+        :param classes: Index of the distribution of effect sizes of each interval
+        :type classes: list
+        :param dfe: Distributions of effect sizes
+        :type dfe: list of :class:`fwdpy11.Sregion`
+
+        Intervals are half-open, may be given in any order,
+        and must not overlap.  Each element of `dfe` must be a
+        distribution of effect sizes, such as :class:`fwdpy11.ExpS`,
+        and not a :class:`fwdpy11.FiniteSites` or a
+        :class:`fwdpy11.MutationIntervalMap`.
+        )delim")
+        .def_static(
+            "from_bed",
+            [](const std::string& filename, py::list dfe) {
+                return fwdpy11::MutationIntervalMap::from_bed(
+                    filename, clone_dfe_classes(dfe));
+            },
+            py::arg("filename"), py::arg("dfe"),
+            R"delim(
+        Read intervals from a BED-like file.
+
+        :param filename: Name of the file
+        :type filename: str
+        :param dfe: Distributions of effect sizes
+        :type dfe: list of :class:`fwdpy11.Sregion`
+
+        Each line contains a chromosome, start, and stop, optionally
+        followed by a rate (default 1) and a class (default 0).  Further
+        columns are ignored, as are blank lines, lines starting with "#",
+        and "track" and "browser" lines.  All intervals must be on the same
+        chromosome.
+        )delim")
+        .def_property_readonly(
+            "starts",
+            [](const fwdpy11::MutationIntervalMap& self) {
+                return self.intervals.starts;
+            },
+            "Start of each interval, in increasing order")
+        .def_property_readonly(
+            "stops",
+            [](const fwdpy11::MutationIntervalMap& self) {
+                return self.intervals.stops;
+            },
+            "End of each interval")
+        .def_property_readonly(
+            "rates",
+            [](const fwdpy11::MutationIntervalMap& self) {
+                return self.intervals.rates;
+            },
+            "Rate per unit length of each interval")
+        .def_property_readonly(
+            "classes",
+            [](const fwdpy11::MutationIntervalMap& self) {
+                return self.intervals.classes;
+            },
+            "Distribution of effect sizes of each interval")
+        .def_property_readonly(
+            "dfe",
+            [](const fwdpy11::MutationIntervalMap& self) {
+                py::list rv;
+                for (auto& d : self.dfe)
+                    {
+                        rv.append(py::cast(d->clone()));
+                    }
+                return rv;
+            },
+            "Copies of the distributions of effect sizes")
+        .def_property_readonly("total",
+                               &fwdpy11::MutationIntervalMap::total,
+                               "Sum of rate times length over all intervals")
+        .def("__repr__", &fwdpy11::MutationIntervalMap::repr)
+        .def(py::pickle(
+            [](const fwdpy11::MutationIntervalMap& self) {
+                return self.pickle();
+            },
+            [](py::tuple t) {
+                return fwdpy11::MutationIntervalMap::unpickle(t);
+            }));
+}
@@ -4,9 +4,47 @@
 #include <pybind11/stl.h>
 #include <fwdpy11/regions/MutationRegions.hpp>
 #include <fwdpy11/regions/ConstantS.hpp>
+#include <fwdpy11/regions/FiniteSites.hpp>
 
 namespace py = pybind11;
 
+namespace
+{
+    void
+    add_neutral_region(const py::handle& h,
+                       std::vector<std::unique_ptr<fwdpy11::Sregion>>& regions,
+                       std::vector<double>& weights)
+    // Neutral regions are Regions or FiniteSites
+    // whose mutations have no effect on fitness.
+    {
+        if (py::isinstance<fwdpy11::FiniteSites>(h))
+            {
+                auto& fs = h.cast<const fwdpy11::FiniteSites&>();
+                auto dfe
+                    = dynamic_cast<const fwdpy11::ConstantS*>(fs.dfe.get());
+                if (dfe == nullptr || dfe->esize != 0.0)
+                    {
+                        throw std::invalid_argument(
+                            "FiniteSites in neutral regions must have "
+                            "no effect on fitness");
+                    }
+                weights.push_back(fs.weight());
+                regions.emplace_back(fs.clone());
+                return;
+            }
+        if (!py::isinstance<fwdpy11::Region>(h))
+            {
+                throw std::invalid_argument(
+                    "neutral regions must be Region or FiniteSites");
+            }
+        auto& n = h.cast<const fwdpy11::Region&>();
+        weights.push_back(n.weight);
+        regions.emplace_back(new fwdpy11::ConstantS(
+            fwdpy11::Region(n.beg, n.end, n.weight, n.coupled, n.label), 1.0,
+            0.0, 0.0));
+    }
+} // namespace
+
 void
 init_MutationRegions(py::module& m)
 {
@@ -14,20 +52,16 @@ init_MutationRegions(py::module& m)
         .def_readonly("weights", &fwdpy11::MutationRegions::weights)
         .def_static(
             "create",
-            [](double pneutral, const std::vector<fwdpy11::Region>& neutral,
+            [](double pneutral, py::list neutral,
                py::list selected) -> fwdpy11::MutationRegions {
                 std::vector<std::unique_ptr<fwdpy11::Sregion>> nregions,
                     sregions;
 
                 std::vector<double> nweights, sweights;
 
-                for (auto& n : neutral)
+                for (auto& i : neutral)
                     {
-                        nweights.push_back(n.weight);
-                        nregions.emplace_back(new fwdpy11::ConstantS(
-                            fwdpy11::Region(n.beg, n.end, n.weight, n.coupled,
-                                            n.label),
-                            1.0, 0.0, 0.0));
+                        add_neutral_region(i, nregions, nweights);
                     }
 
                 for (auto& s : selected)
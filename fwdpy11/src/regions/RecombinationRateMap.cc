@@ -0,0 +1,59 @@
+#include <pybind11/stl.h>
+#include <fwdpy11/regions/RecombinationRateMap.hpp>
+
+namespace py = pybind11;
+
+void
+init_RecombinationRateMap(py::module& m)
+{
+    py::class_<fwdpy11::RecombinationRateMap, fwdpy11::GeneticMapUnit>(
+        m, "RecombinationRateMap",
+        R"delim(
+        Piecewise-constant recombination rate map.
+
+        The number of crossovers per gamete is a single Poisson
+        deviate whose mean is the total map length.  Each breakpoint
+        is then placed by a binary search of the cumulative map.
+        Thus, the cost of generating a gamete does not depend on the
+        number of intervals in the map, in contrast to using one
+        :class:`fwdpy11.PoissonInterval` per interval.
+        )delim")
+        .def(py::init<std::vector<double>, std::vector<double>>(),
+             py::arg("positions"), py::arg("rates"),
+             R"delim(
+        :param positions: Interval boundaries, in increasing order
+        :type positions: list
+        :param rates: Crossovers per unit length per gamete in each interval
+        :type rates: list
+
+        `rates[i]` applies to the interval from `positions[i]` to
+        `positions[i + 1]`, so there must be one more position than rates.
+        )delim")
+        .def_static("from_hapmap", &fwdpy11::RecombinationRateMap::from_hapmap,
+                    py::arg("filename"), py::arg("scaling") = 1.0,
+                    R"delim(
+        Read a map from a HapMap-style text file.
+
+        :param filename: Name of the file
+        :type filename: str
+        :param scaling: (1.0) Value to multiply all rates by
+        :type scaling: float
+
+        Each line contains either chromosome, position (bp), rate (cM/Mb)
+        and map position (cM), or just the last three of these.  A header line
+        is skipped.  The rate on each line applies from its position up to
+        the position on the next line.  Rates are converted to crossovers per
+        base pair.
+        )delim")
+        .def_readonly("positions", &fwdpy11::RecombinationRateMap::positions,
+                      "Interval boundaries")
+        .def_readonly("rates", &fwdpy11::RecombinationRateMap::rates,
+                      "Rate in each interval")
+        .def_property_readonly("total", &fwdpy11::RecombinationRateMap::total,
+                               "Expected number of crossovers per gamete")
+        .def(py::pickle(
+            [](const fwdpy11::RecombinationRateMap& r) { return r.pickle(); },
+            [](py::object o) {
+                return fwdpy11::RecombinationRateMap::unpickle(o);
+            }));
+}
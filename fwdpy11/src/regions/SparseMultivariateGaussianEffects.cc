@@ -0,0 +1,98 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <fwdpy11/regions/SparseMultivariateGaussianEffects.hpp>
+
+namespace py = pybind11;
+
+void
+init_SparseMultivariateGaussianEffects(py::module& m)
+{
+    py::class_<fwdpy11::SparseMultivariateGaussianEffects,
+               fwdpy11::MultivariateGaussianEffects>(
+        m, "SparseMultivariateGaussianEffects",
+        R"delim(
+        Pleiotropic effects on a subset of traits via a multivariate
+        Gaussian distribution.
+
+        Mutations from this region have effect sizes for all traits,
+        but only those on the traits given to the constructor are
+        non-zero.  :class:`fwdpy11.StrictAdditiveMultivariateEffects`
+        stores and adds only the non-zero effect sizes when most
+        effect sizes are zero.
+
+        The effect sizes of each mutation are stored for all traits,
+        so the memory used by a mutation, and the time taken to create
+        it, grow with the total number of traits rather than with the
+        number of traits affected.
+        )delim")
+        .def(py::init([](double beg, double end, double weight,
+                         std::size_t ndim, py::array_t<std::size_t> traits,
+                         py::array_t<double> cov_matrix, double fixed_effect,
+                         double h, bool coupled, std::uint16_t label) {
+                 auto r = cov_matrix.unchecked<2>();
+                 if (r.shape(0) != r.shape(1))
+                     {
+                         throw std::invalid_argument(
+                             "input matrix is not square");
+                     }
+                 auto t = traits.unchecked<1>();
+                 std::vector<std::size_t> vtraits;
+                 for (py::ssize_t i = 0; i < t.shape(0); ++i)
+                     {
+                         vtraits.push_back(t(i));
+                     }
+                 gsl_matrix_const_view v = gsl_matrix_const_view_array(
+                     r.data(0, 0), r.shape(0), r.shape(1));
+                 return fwdpy11::SparseMultivariateGaussianEffects(
+                     fwdpy11::MultivariateGaussianEffects(
+                         fwdpy11::Region(beg, end, weight, coupled, label),
+                         1.0, v.matrix, fixed_effect, h, true),
+                     ndim, std::move(vtraits));
+             }),
+             py::arg("beg"), py::arg("end"), py::arg("weight"),
+             py::arg("ndim"), py::arg("traits"), py::arg("matrix"),
+             py::arg("fixed_effect") = 0.0, py::arg("h") = 1.0,
+             py::arg("coupled") = true, py::arg("label") = 0,
+             R"delim(
+             Constructor
+
+             :param beg: Beginning of the region
+             :type beg: float
+             :param end: End of the region
+             :type end: float
+             :param weight: Weight on the region
+             :type weight: float
+             :param ndim: Total number of traits
+             :type ndim: int
+             :param traits: Indexes of the traits affected by mutations
+             :type traits: numpy array
+             :param matrix: Variance-covariance matrix of the effects on `traits`
+             :type matrix: numpy ndarray
+             :param fixed_effect: Fixed effect size. Defaults to 0.0.
+             :type fixed_effect: float
+             :param h: Dominance. Defaults to 1.0
+             :type h: float
+             :param coupled: Specify if weight is function of end-beg or not. Defaults to True
+             :type coupled: bool
+             :param label: Label for mutations from this region. Defaults to 0.
+             :type label: np.uint16
+
+             Row and column `i` of the matrix refer to trait `traits[i]`.
+             The trait indexes must be unique and less than `ndim`.
+             Otherwise, the requirements are those of
+             :class:`fwdpy11.MultivariateGaussianEffects`.
+             )delim")
+        .def(py::pickle(
+            [](const fwdpy11::SparseMultivariateGaussianEffects& self) {
+                return self.pickle();
+            },
+            [](py::tuple t) {
+                return fwdpy11::SparseMultivariateGaussianEffects::unpickle(t);
+            }))
+        .def("__repr__", &fwdpy11::SparseMultivariateGaussianEffects::repr)
+        .def("__eq__",
+             [](const fwdpy11::SparseMultivariateGaussianEffects& lhs,
+                const fwdpy11::SparseMultivariateGaussianEffects& rhs) {
+                 return lhs == rhs;
+             });
+}
@@ -12,11 +12,15 @@ void init_GaussianS(py::module &);
 void init_MutationRegions(py::module &);
 void init_RecombinationRegions(py::module &);
 void init_MultivariateGaussianEffects(py::module &);
+void init_SparseMultivariateGaussianEffects(py::module &);
 void init_GeneticMapUnit(py::module &);
 void init_PoissonInterval(py::module &);
 void init_BinomialPoint(py::module &);
 void init_PoissonPoint(py::module &);
 void init_FixedCrossovers(py::module &);
+void init_RecombinationRateMap(py::module &);
+void init_MutationIntervalMap(py::module &);
+void init_FiniteSites(py::module &);
 
 void
 initialize_regions(py::module &m)
@@ -31,9 +35,13 @@ initialize_regions(py::module &m)
     init_MutationRegions(m);
     init_RecombinationRegions(m);
     init_MultivariateGaussianEffects(m);
+    init_SparseMultivariateGaussianEffects(m);
     init_GeneticMapUnit(m);
     init_PoissonInterval(m);
     init_BinomialPoint(m);
     init_PoissonPoint(m);
     init_FixedCrossovers(m);
+    init_RecombinationRateMap(m);
+    init_MutationIntervalMap(m);
+    init_FiniteSites(m);
 }
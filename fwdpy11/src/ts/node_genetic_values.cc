@@ -0,0 +1,290 @@
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/types/Population.hpp>
+#include <fwdpp/ts/tree_visitor.hpp>
+
+namespace py = pybind11;
+
+PYBIND11_MAKE_OPAQUE(std::vector<fwdpy11::Mutation>);
+
+namespace
+{
+    fwdpp::ts::table_collection
+    tables_overlapping(const fwdpp::ts::table_collection& tables,
+                       const double left, const double right)
+    // Returns a copy of tables containing the parts of the
+    // edges overlapping [left, right], so that the first
+    // non-empty tree visited starts at left.  This lets a
+    // thread start at its own interval without visiting the
+    // trees to its left.  Mutations are not copied.
+    {
+        fwdpp::ts::table_collection rv(tables.genome_length());
+        rv.node_table = tables.node_table;
+        for (const auto& e : tables.edge_table)
+            {
+                if (e.right > left && e.left <= right)
+                    {
+                        rv.edge_table.push_back(e);
+                        rv.edge_table.back().left = std::max(e.left, left);
+                    }
+            }
+        rv.build_indexes();
+        return rv;
+    }
+
+    void
+    accumulate_interval(const fwdpp::ts::table_collection& tables,
+                        const fwdpp::ts::mutation_key_vector& records,
+                        const std::vector<fwdpy11::Mutation>& mutations,
+                        const std::vector<fwdpp::ts::TS_NODE_INT>& samples,
+                        const std::size_t first, const std::size_t last,
+                        const std::size_t ndim, const bool include_neutral,
+                        std::vector<double>& output)
+    // Adds the effects of mutation records first to last - 1
+    // to the samples that inherit them, visiting the trees
+    // of tables.  Row i of output holds the values for samples[i].
+    {
+        const std::size_t width = std::max<std::size_t>(ndim, 1);
+        fwdpp::ts::tree_visitor tv(tables, samples);
+        if (tv(std::true_type(), std::true_type()) == false)
+            {
+                throw std::invalid_argument(
+                    "TableCollection contains no trees");
+            }
+        const auto& tree = tv.tree();
+        for (auto r = first; r < last; ++r)
+            {
+                const auto& record = records[r];
+                const auto& mut = mutations[record.key];
+                if (mut.neutral && !include_neutral)
+                    {
+                        continue;
+                    }
+                while (mut.pos >= tree.right)
+                    {
+                        if (tv(std::true_type(), std::true_type()) == false)
+                            {
+                                throw std::runtime_error(
+                                    "tree traversal error");
+                            }
+                    }
+                if (ndim > 0 && mut.esizes.size() != ndim)
+                    {
+                        throw std::invalid_argument(
+                            "mutation effect sizes do not have ndim "
+                            "elements");
+                    }
+                auto ls = tree.left_sample[record.node];
+                if (ls == fwdpp::ts::TS_NULL_NODE)
+                    {
+                        continue;
+                    }
+                const auto rs = tree.right_sample[record.node];
+                while (true)
+                    {
+                        // As in VariantIterator, the sample lists of
+                        // the tree contain indexes into samples, not
+                        // node IDs, so ls is the row of output.
+                        auto row = output.data() + ls * width;
+                        if (ndim == 0)
+                            {
+                                row[0] += mut.s;
+                            }
+                        else
+                            {
+                                for (std::size_t t = 0; t < ndim; ++t)
+                                    {
+                                        row[t] += mut.esizes[t];
+                                    }
+                            }
+                        if (ls == rs)
+                            {
+                                break;
+                            }
+                        ls = tree.next_sample[ls];
+                    }
+            }
+    }
+
+    py::array
+    node_genetic_values(const fwdpp::ts::table_collection& tables,
+                        const std::vector<fwdpy11::Mutation>& mutations,
+                        const std::vector<fwdpp::ts::TS_NODE_INT>& samples,
+                        const std::size_t ndim, const bool include_neutral,
+                        const unsigned nthreads)
+    // Mutation records are split into nthreads intervals of
+    // equal size.  Each thread visits the trees overlapping
+    // its interval and writes to its own buffer.  Threads
+    // other than the first copy the edges overlapping their
+    // interval (see tables_overlapping), so that the trees are
+    // traversed once in total rather than once per thread
+    // up to the thread's interval.
+    {
+        if (nthreads == 0)
+            {
+                throw std::invalid_argument("nthreads must be > 0");
+            }
+        if (samples.empty())
+            {
+                throw std::invalid_argument("empty list of samples");
+            }
+        const auto& mt = tables.mutation_table;
+        for (std::size_t i = 1; i < mt.size(); ++i)
+            {
+                if (mutations[mt[i].key].pos < mutations[mt[i - 1].key].pos)
+                    {
+                        throw std::invalid_argument(
+                            "mutation table is not sorted by position");
+                    }
+            }
+        const std::size_t width = std::max<std::size_t>(ndim, 1);
+        const std::size_t nintervals
+            = std::max<std::size_t>(1, std::min<std::size_t>(nthreads,
+                                                             mt.size()));
+        std::vector<std::vector<double>> partial(
+            nintervals, std::vector<double>(samples.size() * width, 0.0));
+        std::exception_ptr error = nullptr;
+        std::atomic<bool> failed(false);
+        const auto worker = [&](const std::size_t i) {
+            try
+                {
+                    const auto first = i * mt.size() / nintervals;
+                    const auto last = (i + 1) * mt.size() / nintervals;
+                    if (first == 0 || first == last)
+                        {
+                            accumulate_interval(tables, mt, mutations,
+                                                samples, first, last, ndim,
+                                                include_neutral, partial[i]);
+                        }
+                    else
+                        {
+                            const auto interval_tables = tables_overlapping(
+                                tables, mutations[mt[first].key].pos,
+                                mutations[mt[last - 1].key].pos);
+                            accumulate_interval(interval_tables, mt,
+                                                mutations, samples, first,
+                                                last, ndim, include_neutral,
+                                                partial[i]);
+                        }
+                }
+            catch (...)
+                {
+                    if (!failed.exchange(true))
+                        {
+                            error = std::current_exception();
+                        }
+                }
+        };
+        {
+            // The GIL is not needed until the results are returned
+            py::gil_scoped_release release;
+            std::vector<std::thread> threads;
+            for (std::size_t i = 1; i < nintervals; ++i)
+                {
+                    threads.emplace_back(worker, i);
+                }
+            worker(0);
+            for (auto& t : threads)
+                {
+                    t.join();
+                }
+        }
+        if (error != nullptr)
+            {
+                std::rethrow_exception(error);
+            }
+        auto& rv = partial[0];
+        for (std::size_t i = 1; i < nintervals; ++i)
+            {
+                std::transform(begin(rv), end(rv), begin(partial[i]),
+                               begin(rv), std::plus<double>());
+            }
+        if (ndim == 0)
+            {
+                return py::array_t<double>(rv.size(), rv.data());
+            }
+        return py::array_t<double>({ samples.size(), ndim }, rv.data());
+    }
+} // namespace
+
+void
+init_node_genetic_values(py::module& m)
+{
+    m.def("node_genetic_values",
+          [](const fwdpy11::Population& pop,
+             const std::vector<fwdpp::ts::TS_NODE_INT>& samples,
+             const std::size_t ndim, const bool include_neutral,
+             const unsigned nthreads) {
+              return node_genetic_values(pop.tables, pop.mutations, samples,
+                                         ndim, include_neutral, nthreads);
+          },
+          py::arg("pop"), py::arg("samples"), py::arg("ndim") = 0,
+          py::arg("include_neutral") = false, py::arg("nthreads") = 1,
+          R"delim(
+          Additive genetic values of nodes, obtained from the tree sequence.
+
+          :param pop: A population
+          :type pop: :class:`fwdpy11.Population`
+          :param samples: List of nodes
+          :type samples: list
+          :param ndim: (0) Number of trait dimensions
+          :type ndim: int
+          :param include_neutral: (False) Include the effects of neutral mutations
+          :type include_neutral: bool
+          :param nthreads: (1) Number of threads
+          :type nthreads: int
+
+          :return: Sum of the effect sizes of the mutations inherited by each node.
+          :rtype: numpy.ndarray
+
+          If `ndim` is 0, :attr:`fwdpy11.Mutation.s` is summed and a 1d array is
+          returned.  Otherwise, :attr:`fwdpy11.Mutation.esizes` is summed and
+          row `i` of the returned 2d array contains the values for `samples[i]`.
+
+          The trees are traversed once, and mutations are only visited in the
+          trees in which they occur.  When `nthreads` is greater than one, the
+          mutation table is split into `nthreads` genomic intervals, which are
+          processed in parallel.
+
+          For a strictly additive model, the genetic value of an individual is
+          the sum of the values of its two nodes.
+          )delim");
+
+    m.def("node_genetic_values",
+          [](const fwdpp::ts::table_collection& tables,
+             const std::vector<fwdpy11::Mutation>& mutations,
+             const std::vector<fwdpp::ts::TS_NODE_INT>& samples,
+             const std::size_t ndim, const bool include_neutral,
+             const unsigned nthreads) {
+              return node_genetic_values(tables, mutations, samples, ndim,
+                                         include_neutral, nthreads);
+          },
+          py::arg("tables"), py::arg("mutations"), py::arg("samples"),
+          py::arg("ndim") = 0, py::arg("include_neutral") = false,
+          py::arg("nthreads") = 1,
+          R"delim(
+          Additive genetic values of nodes, obtained from the tree sequence.
+
+          :param tables: A table collection
+          :type tables: :class:`fwdpy11.ts.TableCollection`
+          :param mutations: Mutation list
+          :type mutations: :class:`fwdpy11.VecMutation`
+          :param samples: List of nodes
+          :type samples: list
+          :param ndim: (0) Number of trait dimensions
+          :type ndim: int
+          :param include_neutral: (False) Include the effects of neutral mutations
+          :type include_neutral: bool
+          :param nthreads: (1) Number of threads
+          :type nthreads: int
+
+          :return: Sum of the effect sizes of the mutations inherited by each node.
+          :rtype: numpy.ndarray
+          )delim");
+}
@@ -0,0 +1,75 @@
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <gsl/gsl_randist.h>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/evolve/discrete_sampler.hpp>
+
+namespace py = pybind11;
+
+// Compare fwdpy11::discrete_sampler to gsl_ran_discrete
+
+std::vector<std::size_t>
+gsl_draws(const std::vector<double>& weights, const unsigned seed,
+          const std::size_t n)
+{
+    std::unique_ptr<gsl_ran_discrete_t, void (*)(gsl_ran_discrete_t*)>
+        lookup(gsl_ran_discrete_preproc(weights.size(), weights.data()),
+               gsl_ran_discrete_free);
+    if (lookup == nullptr)
+        {
+            throw std::invalid_argument("gsl_ran_discrete_preproc failed");
+        }
+    fwdpy11::GSLrng_t rng(seed);
+    std::vector<std::size_t> rv;
+    for (std::size_t i = 0; i < n; ++i)
+        {
+            rv.push_back(gsl_ran_discrete(rng.get(), lookup.get()));
+        }
+    return rv;
+}
+
+std::vector<std::size_t>
+sampler_draws(const std::vector<std::vector<double>>& weights,
+              const unsigned seed, const std::size_t n, const bool batched)
+// The sampler is built for each element of weights in turn,
+// and the last table is sampled, one draw at a time or via sample.
+{
+    fwdpy11::discrete_sampler sampler;
+    for (auto& w : weights)
+        {
+            sampler.assign(w);
+        }
+    fwdpy11::GSLrng_t rng(seed);
+    std::vector<std::size_t> rv(n);
+    if (batched)
+        {
+            sampler.sample(rng, n, rv.data());
+        }
+    else
+        {
+            for (auto& i : rv)
+                {
+                    i = sampler(rng);
+                }
+        }
+    return rv;
+}
+
+PYBIND11_MODULE(discrete_sampler, m)
+{
+    m.def("gsl_draws", &gsl_draws, py::arg("weights"), py::arg("seed"),
+          py::arg("n"));
+    m.def("sampler_draws", &sampler_draws, py::arg("weights"),
+          py::arg("seed"), py::arg("n"), py::arg("batched") = false);
+    m.def("sampler_size", [](const std::vector<std::vector<double>>& weights) {
+        fwdpy11::discrete_sampler sampler;
+        for (auto& w : weights)
+            {
+                sampler.assign(w);
+            }
+        return sampler.size();
+    });
+}
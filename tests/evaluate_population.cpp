@@ -0,0 +1,53 @@
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/types/DiploidPopulation.hpp>
+#include <fwdpy11/genetic_values/DiploidPopulationGeneticValue.hpp>
+
+namespace py = pybind11;
+
+// Expose the two ways of evaluating a generation for unit testing
+
+py::list
+metadata_values(const std::vector<fwdpy11::DiploidMetadata>& metadata)
+{
+    py::list rv;
+    for (auto& md : metadata)
+        {
+            rv.append(py::make_tuple(md.g, md.e, md.w));
+        }
+    return rv;
+}
+
+py::list
+evaluate_population(const fwdpy11::DiploidPopulationGeneticValue& gv,
+                    const fwdpy11::DiploidPopulation& pop,
+                    const unsigned seed)
+// Evaluates pop as a simulation does.
+// Returns the g, e, and w of each diploid.
+{
+    fwdpy11::GSLrng_t rng(seed);
+    auto metadata = pop.diploid_metadata;
+    gv.evaluate_population(rng, pop, metadata, nullptr);
+    return metadata_values(metadata);
+}
+
+py::list
+evaluate_each_diploid(const fwdpy11::DiploidPopulationGeneticValue& gv,
+                      const fwdpy11::DiploidPopulation& pop,
+                      const unsigned seed)
+// Evaluates pop via the virtual calls for each diploid
+// made by the default evaluate_population.
+{
+    fwdpy11::GSLrng_t rng(seed);
+    auto metadata = pop.diploid_metadata;
+    gv.fwdpy11::DiploidPopulationGeneticValue::evaluate_population(
+        rng, pop, metadata, nullptr);
+    return metadata_values(metadata);
+}
+
+PYBIND11_MODULE(evaluate_population, m)
+{
+    m.def("evaluate_population", &evaluate_population);
+    m.def("evaluate_each_diploid", &evaluate_each_diploid);
+}
@@ -0,0 +1,114 @@
+/* A frequency-dependent fitness model
+ * using the population-aggregate API.
+ *
+ * Fitness declines with the squared distance
+ * of an individual's genetic value from the
+ * mean genetic value of the population.
+ * Thus, the optimum moves with the population.
+ *
+ * The mean is computed once per generation,
+ * so the cost of a generation is O(N).
+ */
+#include <cmath>
+#include <pybind11/pybind11.h>
+#include <fwdpp/fitness_models.hpp>
+#include <fwdpy11/genetic_values/DiploidPopulationGeneticValueWithAggregate.hpp>
+#include <fwdpy11/genetic_values/default_update.hpp>
+
+struct mean_relative_fitness
+    : public fwdpy11::DiploidPopulationGeneticValueWithAggregate
+{
+    const double VS;
+    // Counts individuals, to test the
+    // user-defined accumulator hooks
+    mutable std::size_t individuals_seen;
+
+    explicit mean_relative_fitness(double VS_)
+        : fwdpy11::DiploidPopulationGeneticValueWithAggregate(1), VS(VS_),
+          individuals_seen(0)
+    {
+    }
+
+    inline double
+    calculate_gvalue(const std::size_t diploid_index,
+                     const fwdpy11::DiploidPopulation& pop) const
+    {
+        gvalues[0] = fwdpp::additive_diploid(fwdpp::trait(2.0))(
+            pop.diploids[diploid_index], pop.gametes, pop.mutations);
+        return gvalues[0];
+    }
+
+    void
+    begin_aggregation() const
+    {
+        individuals_seen = 0;
+    }
+
+    void
+    aggregate_individual(const fwdpy11::DiploidMetadata& /*metadata*/) const
+    {
+        ++individuals_seen;
+    }
+
+    using fwdpy11::DiploidPopulationGeneticValueWithAggregate::
+        genetic_value_to_fitness;
+
+    double
+    genetic_value_to_fitness(
+        const fwdpy11::DiploidMetadata& metadata,
+        const fwdpy11::PopulationAggregate& aggregate) const
+    {
+        double d = metadata.g - aggregate.g.mean();
+        return std::exp(-d * d / (2.0 * VS));
+    }
+
+    double
+    noise(const fwdpy11::GSLrng_t& /*rng*/,
+          const fwdpy11::DiploidMetadata& /*offspring_metadata*/,
+          const std::size_t /*parent1*/, const std::size_t /*parent2*/,
+          const fwdpy11::DiploidPopulation& /*pop*/) const
+    {
+        return 0.0;
+    }
+
+    pybind11::object
+    pickle() const
+    {
+        return pybind11::make_tuple(VS);
+    }
+    DEFAULT_DIPLOID_POP_UPDATE();
+
+    pybind11::tuple
+    shape() const
+    {
+        return pybind11::make_tuple(1);
+    }
+};
+
+PYBIND11_MODULE(frequency_dependent, m)
+{
+    // The base class must be registered before it is used below
+    pybind11::module::import("fwdpy11");
+    pybind11::class_<mean_relative_fitness,
+                     fwdpy11::DiploidPopulationGeneticValue>(
+        m, "MeanRelativeFitness")
+        .def(pybind11::init<double>(), pybind11::arg("VS"))
+        .def_readonly("VS", &mean_relative_fitness::VS)
+        .def_readonly("individuals_seen",
+                      &mean_relative_fitness::individuals_seen)
+        .def_property_readonly(
+            "mean_genetic_value",
+            [](const mean_relative_fitness& m) {
+                return m.aggregate.g.mean();
+            })
+        .def(pybind11::pickle(
+            [](const mean_relative_fitness& m) { return m.pickle(); },
+            [](pybind11::object o) {
+                pybind11::tuple t(o);
+                if (t.size() != 1)
+                    {
+                        throw std::runtime_error("invalid object state");
+                    }
+                return mean_relative_fitness(t[0].cast<double>());
+            }));
+}
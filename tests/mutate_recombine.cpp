@@ -0,0 +1,121 @@
+#include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <fwdpp/forward_types.hpp>
+#include <fwdpp/simfunctions/recycling.hpp>
+#include <fwdpy11/types/Mutation.hpp>
+#include <fwdpy11/evolve/mutate_recombine.hpp>
+
+namespace py = pybind11;
+
+// Expose fwdpy11::recombine_keys and fwdpy11::mutate_recombine
+// for unit testing.  Mutations are given as (position, s) tuples
+// and are neutral if s == 0.  Gametes are given as (n, neutral keys,
+// selected keys) tuples.  Breakpoints are given without the terminating
+// std::numeric_limits<double>::max(), which is appended here.
+
+using keys_t = std::vector<fwdpp::uint_t>;
+
+struct record_new_gametes
+{
+    std::vector<std::size_t> indexes;
+
+    void
+    new_gamete(std::size_t g)
+    {
+        indexes.push_back(g);
+    }
+};
+
+std::vector<fwdpy11::Mutation>
+make_mutations(const std::vector<std::pair<double, double>>& mutations)
+{
+    std::vector<fwdpy11::Mutation> rv;
+    for (auto& m : mutations)
+        {
+            rv.emplace_back(m.first, m.second, 1.0, 0);
+        }
+    return rv;
+}
+
+std::vector<double>
+terminated(std::vector<double> breakpoints)
+{
+    if (!breakpoints.empty())
+        {
+            breakpoints.push_back(std::numeric_limits<double>::max());
+        }
+    return breakpoints;
+}
+
+std::string
+result_name(const fwdpy11::recombination_result r)
+{
+    switch (r)
+        {
+        case fwdpy11::recombination_result::first_gamete:
+            return "first";
+        case fwdpy11::recombination_result::second_gamete:
+            return "second";
+        default:
+            return "new";
+        }
+}
+
+std::pair<keys_t, std::string>
+recombine_keys(const std::vector<double>& positions,
+               const std::vector<double>& breakpoints, const keys_t& first,
+               const keys_t& second)
+{
+    std::vector<std::pair<double, double>> m;
+    for (auto p : positions)
+        {
+            m.emplace_back(p, 0.0);
+        }
+    auto mutations = make_mutations(m);
+    keys_t output;
+    auto r = fwdpy11::recombine_keys(terminated(breakpoints), first,
+                                     second, mutations, output);
+    return std::make_pair(output, result_name(r));
+}
+
+py::tuple
+mutate_recombine(
+    const std::vector<std::pair<double, double>>& mutations,
+    const std::vector<std::tuple<fwdpp::uint_t, keys_t, keys_t>>& gametes,
+    const keys_t& new_mutations, const std::vector<double>& breakpoints,
+    const std::size_t g1, const std::size_t g2)
+// Returns the offspring's index, the gametes afterwards, and the
+// indexes passed to the observer.
+{
+    auto m = make_mutations(mutations);
+    std::vector<fwdpp::gamete> g;
+    for (auto& t : gametes)
+        {
+            g.emplace_back(std::get<0>(t), std::get<1>(t), std::get<2>(t));
+        }
+    auto gamete_recycling_bin = fwdpp::make_gamete_queue(g);
+    keys_t neutral, selected;
+    record_new_gametes observer;
+    auto rv = fwdpy11::mutate_recombine(
+        new_mutations, terminated(breakpoints), g1, g2, g, m,
+        gamete_recycling_bin, neutral, selected, observer);
+    std::vector<std::pair<keys_t, keys_t>> keys;
+    for (auto& gi : g)
+        {
+            keys.emplace_back(gi.mutations, gi.smutations);
+        }
+    return py::make_tuple(rv, keys, observer.indexes);
+}
+
+PYBIND11_MODULE(mutate_recombine, m)
+{
+    m.def("recombine_keys", &recombine_keys, py::arg("positions"),
+          py::arg("breakpoints"), py::arg("first"), py::arg("second"));
+    m.def("mutate_recombine", &mutate_recombine, py::arg("mutations"),
+          py::arg("gametes"), py::arg("new_mutations"),
+          py::arg("breakpoints"), py::arg("g1"), py::arg("g2"));
+}
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/types/mutation_position_index.hpp>
+
+namespace py = pybind11;
+
+// Expose fwdpy11::mutation_position_index for unit testing
+
+std::vector<std::uint32_t>
+keys_at(const fwdpy11::mutation_position_index& index, const double pos)
+{
+    std::vector<std::uint32_t> rv;
+    auto r = index.equal_range(pos);
+    for (; r.first != r.second; ++r.first)
+        {
+            rv.push_back(r.first->second);
+        }
+    std::sort(rv.begin(), rv.end());
+    return rv;
+}
+
+std::size_t
+erase_keys(fwdpy11::mutation_position_index& index, const double pos,
+           const std::vector<std::uint32_t>& keys)
+// Erase the entries at pos whose keys are in keys
+// while iterating over equal_range(pos).
+{
+    std::size_t n = 0;
+    auto r = index.equal_range(pos);
+    for (; r.first != r.second; ++r.first)
+        {
+            if (std::find(keys.begin(), keys.end(), r.first->second)
+                != keys.end())
+                {
+                    index.erase(r.first);
+                    ++n;
+                }
+        }
+    return n;
+}
+
+PYBIND11_MODULE(mutation_position_index, m)
+{
+    py::class_<fwdpy11::mutation_position_index>(m, "MutationPositionIndex")
+        .def(py::init<>())
+        .def("__len__", &fwdpy11::mutation_position_index::size)
+        .def("emplace",
+             [](fwdpy11::mutation_position_index& index, const double pos,
+                const std::uint32_t key) { index.emplace(pos, key); })
+        .def("erase",
+             [](fwdpy11::mutation_position_index& index, const double pos) {
+                 return index.erase(pos);
+             })
+        .def("erase_keys", &erase_keys)
+        .def("count", &fwdpy11::mutation_position_index::count)
+        .def("keys_at", &keys_at)
+        .def("reserve", &fwdpy11::mutation_position_index::reserve)
+        .def("clear", &fwdpy11::mutation_position_index::clear)
+        .def("entries",
+             [](const fwdpy11::mutation_position_index& index) {
+                 std::vector<std::pair<double, std::uint32_t>> rv(
+                     index.begin(), index.end());
+                 std::sort(rv.begin(), rv.end());
+                 return rv;
+             })
+        .def("index_sites", &fwdpy11::mutation_position_index::index_sites)
+        .def("site_occupied",
+             &fwdpy11::mutation_position_index::site_occupied)
+        .def("unoccupied_sites",
+             &fwdpy11::mutation_position_index::unoccupied_sites)
+        .def("unoccupied_site",
+             &fwdpy11::mutation_position_index::unoccupied_site)
+        .def("__eq__",
+             [](const fwdpy11::mutation_position_index& a,
+                const fwdpy11::mutation_position_index& b) { return a == b; })
+        .def("__ne__",
+             [](const fwdpy11::mutation_position_index& a,
+                const fwdpy11::mutation_position_index& b) {
+                 return a != b;
+             });
+}
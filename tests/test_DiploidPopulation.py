@@ -130,6 +130,21 @@ class testPythonObjects(unittest.TestCase):
             for i in indexes:
                 self.assertTrue(i in val)
 
+    def testMutationIndicesAllExtant(self):
+        params = fwdpy11.ModelParams(**self.pdict)
+        fwdpy11.evolve_genomes(self.rng, self.pop, params)
+        nextant = 0
+        for i, m in enumerate(self.pop.mutations):
+            indexes = self.pop.mutation_indexes(m.pos)
+            if self.pop.mcounts[i] > 0:
+                nextant += 1
+                self.assertTrue(indexes is not None)
+                self.assertTrue(i in indexes)
+            elif indexes is not None:
+                self.assertTrue(i not in indexes)
+        self.assertTrue(nextant > 0)
+        self.assertTrue(self.pop.mutation_indexes(-1.0) is None)
+
     def testEmptyMutationLookupTable(self):
         """
         This test does not use the class fixture.
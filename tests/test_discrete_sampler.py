@@ -0,0 +1,63 @@
+import unittest
+
+import numpy as np
+import fwdpy11  # NOQA
+import discrete_sampler as ds
+
+
+class testDiscreteSampler(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        np.random.seed(42)
+        self.weights = list(np.random.exponential(1.0, 1000))
+        self.n = 10000
+
+    def assertSameDraws(self, weights, previous=[]):
+        for seed in [42, 101, 666]:
+            expected = ds.gsl_draws(weights, seed, self.n)
+            for batched in [False, True]:
+                draws = ds.sampler_draws(previous + [weights], seed, self.n,
+                                         batched)
+                self.assertEqual(draws, expected)
+
+    def testSameAsGSL(self):
+        self.assertSameDraws(self.weights)
+
+    def testEqualWeights(self):
+        self.assertSameDraws([1.0] * 100)
+
+    def testOneWeight(self):
+        self.assertSameDraws([3.0])
+
+    def testZeroWeights(self):
+        weights = [0.0 if i % 3 == 0 else w
+                   for i, w in enumerate(self.weights)]
+        self.assertSameDraws(weights)
+        draws = ds.sampler_draws([weights], 42, self.n)
+        self.assertTrue(all(i % 3 != 0 for i in draws))
+
+    def testRebuildWithFewerWeights(self):
+        """
+        The same object is reused for a smaller table,
+        so storage from the first table must not leak
+        into the second.
+        """
+        weights = self.weights[:100]
+        weights[10] = 0.0
+        self.assertSameDraws(weights, [self.weights])
+        self.assertEqual(ds.sampler_size([self.weights, weights]), 100)
+
+    def testRebuildWithMoreWeights(self):
+        self.assertSameDraws(self.weights, [self.weights[:100]])
+
+    def testInvalidWeights(self):
+        with self.assertRaises(ValueError):
+            ds.sampler_draws([[]], 42, 1)
+        with self.assertRaises(ValueError):
+            ds.sampler_draws([[1.0, -1.0]], 42, 1)
+        with self.assertRaises(ValueError):
+            ds.sampler_draws([[1.0, np.inf]], 42, 1)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,114 @@
+import unittest
+
+import fwdpy11
+import numpy as np
+import evaluate_population as ep
+
+
+class testFusedEvaluation(unittest.TestCase):
+    """
+    The built-in genetic value models evaluate a generation
+    with statically dispatched calls to the noise and
+    fitness functions.  For a given seed, the metadata must
+    be identical to those from calling each diploid's
+    genetic value, noise, and fitness functions in turn.
+    """
+    @classmethod
+    def setUpClass(self):
+        self.N = 500
+        self.p = fwdpy11.ModelParams()
+        self.p.rates = (0.0, 2e-2, 1e-2)
+        self.p.demography = np.array([self.N] * 100, dtype=np.uint32)
+        self.p.nregions = []
+        # Positive effect sizes keep GBR genetic values finite
+        self.p.sregions = [fwdpy11.ExpS(0, 1, 1, 0.05, 0.5)]
+        self.p.recregions = [fwdpy11.Region(0, 1, 1)]
+        self.p.gvalue = fwdpy11.Additive(2.0, fwdpy11.GSS(VS=1, opt=0))
+        self.pop = fwdpy11.DiploidPopulation(self.N)
+        fwdpy11.evolve_genomes(fwdpy11.GSLrng(42), self.pop, self.p)
+
+    def compare(self, gv):
+        fused = ep.evaluate_population(gv, self.pop, 101)
+        each = ep.evaluate_each_diploid(gv, self.pop, 101)
+        self.assertEqual(len(fused), self.N)
+        self.assertEqual(fused, each)
+        return fused
+
+    def noise(self):
+        return fwdpy11.GaussianNoise(sd=0.1, mean=0.0)
+
+    def gv2w(self):
+        return [fwdpy11.GSS(VS=1, opt=0),
+                fwdpy11.GSSmo([(0, 0.0, 1.0), (100, 1.0, 1.0)])]
+
+    def testPopulationHasMutations(self):
+        self.assertTrue(len(self.pop.mutations) > 0)
+
+    def testAdditive(self):
+        self.compare(fwdpy11.Additive(2.0))
+        for gv2w in self.gv2w():
+            self.compare(fwdpy11.Additive(2.0, gv2w))
+            rv = self.compare(fwdpy11.Additive(2.0, gv2w, self.noise()))
+            self.assertEqual(len(set([i[1] for i in rv])), self.N)
+
+    def testMultiplicative(self):
+        self.compare(fwdpy11.Multiplicative(2.0))
+        for gv2w in self.gv2w():
+            self.compare(fwdpy11.Multiplicative(2.0, gv2w))
+            rv = self.compare(fwdpy11.Multiplicative(2.0, gv2w,
+                                                     self.noise()))
+            self.assertEqual(len(set([i[1] for i in rv])), self.N)
+
+    def testGBR(self):
+        for gv2w in self.gv2w():
+            self.compare(fwdpy11.GBR(gv2w))
+            rv = self.compare(fwdpy11.GBR(gv2w, self.noise()))
+            self.assertEqual(len(set([i[1] for i in rv])), self.N)
+
+
+
+class testStrictAdditiveMultivariateEffects(unittest.TestCase):
+    """
+    The trait values calculated for the whole population
+    during a simulation must equal those obtained by calling
+    the genetic value object for each individual.
+    """
+    def run_and_compare(self, ndim, sregions, L):
+        N = 250
+        gv2w = fwdpy11.MultivariateGSS(np.zeros(ndim), 1.0)
+        p = {'nregions': [],
+             'sregions': sregions,
+             'recregions': [fwdpy11.Region(0, L, 1)],
+             'rates': (0.0, 1e-2, 1e-3),
+             'gvalue': fwdpy11.StrictAdditiveMultivariateEffects(
+                 ndim, 0, gv2w),
+             'prune_selected': False,
+             'demography': np.array([N] * 50, dtype=np.uint32)
+             }
+        params = fwdpy11.ModelParams(**p)
+        pop = fwdpy11.DiploidPopulation(N, L)
+        fwdpy11.evolvets(fwdpy11.GSLrng(42), pop, params, 10,
+                         record_gvalue_matrix=True)
+        self.assertTrue(len(pop.mutations) > 0)
+        values = pop.genetic_values
+        self.assertTrue(np.any(values != 0.0))
+        gv = params.gvalue
+        for i, md in enumerate(pop.diploid_metadata):
+            self.assertEqual(gv(i, pop), md.g)
+            self.assertTrue(np.array_equal(gv.genetic_values, values[i, :]))
+
+    def testDenseEffectSizes(self):
+        self.run_and_compare(2, [fwdpy11.MultivariateGaussianEffects(
+            0, 1, 1, np.identity(2) * 0.1)], 1.0)
+
+    def testSparseEffectSizes(self):
+        ndim = 50
+        regions = [fwdpy11.SparseMultivariateGaussianEffects(
+            i, i + 1, 1, ndim, np.array([i, (i + 1) % ndim]),
+            np.identity(2) * 0.1) for i in range(5)]
+        self.run_and_compare(ndim, regions, 5.0)
+
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -63,5 +63,36 @@ class testGaussianNoise(unittest.TestCase):
         self.assertEqual(up.mean, self.mean)
 
 
+class testGaussianNoiseDuringSimulation(unittest.TestCase):
+    """
+    Noise is generated for an entire generation
+    at once, via GaussianNoise's batch API.
+    """
+    @classmethod
+    def setUpClass(self):
+        import numpy as np
+        import fwdpy11
+        self.N = 5000
+        self.p = fwdpy11.ModelParams()
+        self.p.rates = (0.0, 0.0, 0.0)
+        self.p.demography = np.array([self.N] * 2, dtype=np.uint32)
+        self.p.nregions = []
+        self.p.sregions = []
+        self.p.recregions = []
+        self.p.gvalue = fwdpy11.Additive(
+            2.0, fwdpy11.GSS(0.0, 1.0),
+            fwdpy11.GaussianNoise(mean=1.0, sd=0.5))
+
+    def testMoments(self):
+        import numpy as np
+        import fwdpy11
+        pop = fwdpy11.DiploidPopulation(self.N)
+        fwdpy11.evolve_genomes(fwdpy11.GSLrng(101), pop, self.p)
+        e = np.array([md.e for md in pop.diploid_metadata])
+        self.assertEqual(len(np.unique(e)), self.N)
+        self.assertAlmostEqual(e.mean(), 1.0, delta=0.05)
+        self.assertAlmostEqual(e.std(), 0.5, delta=0.05)
+
+
 if __name__ == "__main__":
     unittest.main()
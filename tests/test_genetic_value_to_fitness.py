@@ -79,5 +79,61 @@ class testMultivariateGSSmo(unittest.TestCase):
         self.assertEqual(self.mvgssmo, up)
 
 
+class testMultivariateGSSCovariance(unittest.TestCase):
+    @classmethod
+    def setUp(self):
+        self.optima = np.array([0., 0., 1., 1.]).reshape(2, 2)
+        self.timepoints = np.array([0, 100], dtype=np.uint32)
+        self.S = np.array([2., 0.5, 0.5, 1.]).reshape(2, 2)
+        self.mvgss = fwdpy11.MultivariateGSSCovariance(
+            self.timepoints, self.optima, self.S)
+
+    def test_pickle(self):
+        import pickle
+        p = pickle.dumps(self.mvgss)
+        up = pickle.loads(p)
+        self.assertEqual(self.mvgss, up)
+        self.assertTrue(np.array_equal(up.covariance, self.S))
+
+    def test_not_positive_definite(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.MultivariateGSSCovariance(
+                np.zeros(2), np.array([-1.0] * 4).reshape(2, 2))
+
+    def test_not_symmetric(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.MultivariateGSSCovariance(
+                np.zeros(2), np.array([1., 0.5, 0., 1.]).reshape(2, 2))
+
+    def test_wrong_dimensions(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.MultivariateGSSCovariance(np.zeros(3), self.S)
+
+    def test_fitness_during_simulation(self):
+        N = 500
+        optimum = np.array([0.1, -0.1])
+        gv2w = fwdpy11.MultivariateGSSCovariance(optimum, self.S)
+        p = {'nregions': [],
+             'sregions': [fwdpy11.MultivariateGaussianEffects(
+                 0, 1, 1, np.identity(2) * 0.1)],
+             'recregions': [fwdpy11.Region(0, 1, 1)],
+             'rates': (0.0, 1e-2, 1e-3),
+             'gvalue': fwdpy11.StrictAdditiveMultivariateEffects(2, 0, gv2w),
+             'prune_selected': False,
+             'demography': np.array([N] * 20, dtype=np.uint32)
+             }
+        params = fwdpy11.ModelParams(**p)
+        pop = fwdpy11.DiploidPopulation(N, 1.0)
+        fwdpy11.evolvets(fwdpy11.GSLrng(42), pop, params, 10,
+                         record_gvalue_matrix=True)
+        Sinv = np.linalg.inv(self.S)
+        gv = pop.genetic_values
+        self.assertTrue(np.any(gv != 0.0))
+        for i, md in enumerate(pop.diploid_metadata):
+            d = gv[i, :] - optimum
+            self.assertAlmostEqual(md.w, np.exp(-d.dot(Sinv).dot(d) / 2.0))
+            self.assertEqual(md.g, gv[i, 0])
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -179,5 +179,209 @@ class testGSSandGSSmoConsistency(unittest.TestCase):
             self.assertEqual(i, j)
 
 
+
+class testHaploidEffectsCache(unittest.TestCase):
+    """
+    For these models, the cached genetic values
+    are the same as the uncached ones, so the
+    two simulations must give the same outcome.
+    """
+    @classmethod
+    def setUpClass(self):
+        self.p = fwdpy11.ModelParams()
+        self.p.rates = (0.0, 5e-3, 1e-3)
+        self.p.demography = np.array([500] * 100, dtype=np.uint32)
+        self.p.nregions = []
+        self.p.sregions = [fwdpy11.ExpS(0, 1, 1, -1e-2, 1.0)]
+        self.p.recregions = [fwdpy11.Region(0, 1, 1)]
+
+    def run_pair(self, gvalue, cached_gvalue, exact=True, **kwargs):
+        cached_gvalue.cache_haploid_effects = True
+        self.assertTrue(cached_gvalue.cache_haploid_effects)
+        pop = fwdpy11.DiploidPopulation(500)
+        self.p.gvalue = gvalue
+        fwdpy11.evolve_genomes(fwdpy11.GSLrng(42), pop, self.p, **kwargs)
+        cpop = fwdpy11.DiploidPopulation(500)
+        self.p.gvalue = cached_gvalue
+        fwdpy11.evolve_genomes(fwdpy11.GSLrng(42), cpop, self.p, **kwargs)
+        self.assertEqual(len(pop.mutations), len(cpop.mutations))
+        for i, j in zip(pop.diploid_metadata, cpop.diploid_metadata):
+            if exact:
+                self.assertEqual(i.g, j.g)
+                self.assertEqual(i.w, j.w)
+            else:
+                self.assertAlmostEqual(i.g, j.g)
+                self.assertAlmostEqual(i.w, j.w)
+
+    def testDefault(self):
+        self.assertFalse(fwdpy11.Additive(2.0).cache_haploid_effects)
+
+    def testAdditiveNotCodominant(self):
+        self.run_pair(fwdpy11.Additive(1.0), fwdpy11.Additive(1.0))
+
+    def testAdditiveCodominant(self):
+        """
+        With h = 1 and scaling = 2, all diploids are
+        obtained from the two summaries.  The sums are
+        taken in a different order, so values may differ
+        by rounding error.
+        """
+        self.run_pair(fwdpy11.Additive(2.0), fwdpy11.Additive(2.0),
+                      exact=False)
+
+    def testAdditiveCodominantCompaction(self):
+        """
+        The cache is kept across generations, and is
+        rebuilt when gametes are compacted.
+        """
+        self.run_pair(fwdpy11.Additive(2.0), fwdpy11.Additive(2.0),
+                      exact=False, gamete_compaction_threshold=0.9)
+
+    def testGBR(self):
+        self.p.sregions = [fwdpy11.ExpS(0, 1, 1, 1e-2, 1.0)]
+        self.run_pair(fwdpy11.GBR(fwdpy11.GSS(0.0, 1.0)),
+                      fwdpy11.GBR(fwdpy11.GSS(0.0, 1.0)))
+        self.p.sregions = [fwdpy11.ExpS(0, 1, 1, -1e-2, 1.0)]
+
+
+class NumpyAdditive(fwdpy11.BatchGeneticValue):
+    """
+    Fitness is 1 + the sum of effect sizes,
+    counting homozygotes twice.
+    """
+    def __init__(self):
+        super().__init__(fwdpy11.GeneticValueIsFitness())
+
+    def batch_gvalues(self, data):
+        s = np.concatenate(([0.0], np.cumsum(data.s[data.keys])))
+        gamete_sums = s[data.offsets[1:]] - s[data.offsets[:-1]]
+        d = data.diploids
+        return 1.0 + gamete_sums[d[:, 0]] + gamete_sums[d[:, 1]]
+
+
+class KeepData(NumpyAdditive):
+    """
+    Keeps the data passed to batch_gvalues after the call.
+    """
+    def __init__(self):
+        super().__init__()
+        self.data = []
+
+    def batch_gvalues(self, data):
+        self.data.append(data)
+        return super().batch_gvalues(data)
+
+
+class WrongLength(NumpyAdditive):
+    def batch_gvalues(self, data):
+        return np.ones(len(data.diploids) - 1)
+
+
+class testBatchGeneticValue(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        self.p = fwdpy11.ModelParams()
+        self.p.rates = (0.0, 5e-3, 1e-3)
+        self.p.demography = np.array([100] * 50, dtype=np.uint32)
+        self.p.nregions = []
+        self.p.sregions = [fwdpy11.ExpS(0, 1, 1, -1e-2, 1.0)]
+        self.p.recregions = [fwdpy11.Region(0, 1, 1)]
+
+    def testGeneticValues(self):
+        pop = fwdpy11.DiploidPopulation(100)
+        self.p.gvalue = NumpyAdditive()
+        fwdpy11.evolve_genomes(fwdpy11.GSLrng(42), pop, self.p)
+        for dip, md in zip(pop.diploids, pop.diploid_metadata):
+            g = 1.0
+            for gamete in (dip.first, dip.second):
+                for k in pop.haploid_genomes[gamete].smutations:
+                    g += pop.mutations[k].s
+            self.assertAlmostEqual(g, md.g)
+            self.assertEqual(md.g, md.w)
+
+    def testSingleIndividual(self):
+        pop = fwdpy11.DiploidPopulation(100)
+        self.p.gvalue = NumpyAdditive()
+        fwdpy11.evolve_genomes(fwdpy11.GSLrng(42), pop, self.p)
+        with self.assertRaises(RuntimeError):
+            self.p.gvalue(0, pop)
+
+    def testDataOutlivesCall(self):
+        pop = fwdpy11.DiploidPopulation(100)
+        self.p.gvalue = KeepData()
+        fwdpy11.evolve_genomes(fwdpy11.GSLrng(42), pop, self.p)
+        self.assertTrue(len(self.p.gvalue.data) > 0)
+        del pop
+        data = self.p.gvalue.data[-1]
+        for attr in ('diploids', 'parents', 'keys', 'offsets', 's', 'h',
+                     'generation'):
+            with self.assertRaises(RuntimeError):
+                getattr(data, attr)
+
+    def testWrongLength(self):
+        pop = fwdpy11.DiploidPopulation(100)
+        self.p.gvalue = WrongLength()
+        with self.assertRaises(RuntimeError):
+            fwdpy11.evolve_genomes(fwdpy11.GSLrng(42), pop, self.p)
+
+
+class testPairwiseEpistasis(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        self.p = fwdpy11.ModelParams()
+        self.p.rates = (0.0, 5e-3, 1e-3)
+        self.p.demography = np.array([200] * 50, dtype=np.uint32)
+        self.p.nregions = []
+        self.p.sregions = [fwdpy11.ExpS(0, 1, 1, -1e-2, 0.5, label=1),
+                           fwdpy11.ExpS(1, 2, 1, -1e-2, 0.5, label=2),
+                           fwdpy11.ExpS(2, 3, 1, -1e-2, 0.5, label=3)]
+        self.p.recregions = [fwdpy11.Region(0, 3, 1)]
+        self.interactions = [(2, 1, 5e-3), (1, 3, -1e-3)]
+
+    def genetic_value(self, pop, dip):
+        keys = list(pop.haploid_genomes[dip.first].smutations) + \
+            list(pop.haploid_genomes[dip.second].smutations)
+        g = 0.0
+        for k in set(keys):
+            m = pop.mutations[k]
+            if keys.count(k) == 2:
+                g += 2.0 * m.s
+            else:
+                g += m.h * m.s
+        labels = [pop.mutations[k].label for k in keys]
+        for a, b, e in self.interactions:
+            g += e * labels.count(a) * labels.count(b)
+        return max(0.0, 1.0 + g)
+
+    def testInteractions(self):
+        gv = fwdpy11.PairwiseEpistasis(2.0, self.interactions)
+        self.assertEqual(gv.interactions, [(1, 2, 5e-3), (1, 3, -1e-3)])
+        self.assertTrue(gv.is_fitness)
+
+    def testInvalidInteractions(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.PairwiseEpistasis(2.0, [(1, 1, 0.1)])
+        with self.assertRaises(ValueError):
+            fwdpy11.PairwiseEpistasis(2.0, [(0, 1, 0.1)])
+        with self.assertRaises(ValueError):
+            fwdpy11.PairwiseEpistasis(2.0, [(1, 2, 0.1), (2, 1, 0.1)])
+
+    def testGeneticValues(self):
+        pop = fwdpy11.DiploidPopulation(200)
+        self.p.gvalue = fwdpy11.PairwiseEpistasis(2.0, self.interactions)
+        fwdpy11.evolve_genomes(fwdpy11.GSLrng(42), pop, self.p)
+        for dip, md in zip(pop.diploids, pop.diploid_metadata):
+            self.assertAlmostEqual(self.genetic_value(pop, dip), md.g)
+
+    def testPickle(self):
+        import pickle
+        gv = fwdpy11.PairwiseEpistasis(2.0, self.interactions,
+                                       fwdpy11.GSS(0.0, 1.0))
+        up = pickle.loads(pickle.dumps(gv, -1))
+        self.assertEqual(up.scaling, gv.scaling)
+        self.assertEqual(up.interactions, gv.interactions)
+        self.assertFalse(up.is_fitness)
+
+
 if __name__ == "__main__":
     unittest.main()
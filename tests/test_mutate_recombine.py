@@ -0,0 +1,204 @@
+import bisect
+import unittest
+
+import numpy as np
+import fwdpy11  # NOQA
+import mutate_recombine as mr
+
+
+def naive_recombination(positions, breakpoints, first, second):
+    """
+    Keys at positions <= breakpoints[0] come from first,
+    those in (breakpoints[0], breakpoints[1]] from second,
+    and so on.
+    """
+    def inherited(keys, parity):
+        return [k for k in keys
+                if bisect.bisect_left(breakpoints, positions[k]) % 2 == parity]
+    rv = inherited(first, 0) + inherited(second, 1)
+    return sorted(rv, key=lambda k: positions[k])
+
+
+class testRecombineKeys(unittest.TestCase):
+    def setUp(self):
+        # first has keys 0-2, second has keys 3-4
+        self.positions = [0.1, 0.2, 0.3, 0.15, 0.25]
+        self.first = [0, 1, 2]
+        self.second = [3, 4]
+
+    def testBreakpointAtKeyPosition(self):
+        """
+        A key at a breakpoint is inherited from the
+        gamete that precedes the breakpoint.
+        """
+        keys, r = mr.recombine_keys(self.positions, [0.2],
+                                    self.first, self.second)
+        self.assertEqual(keys, [0, 1, 4])
+        self.assertEqual(r, "new")
+        # Key 3 is at the breakpoint and is not inherited
+        keys, r = mr.recombine_keys(self.positions, [0.15],
+                                    self.first, self.second)
+        self.assertEqual(keys, [0, 4])
+        keys, r = mr.recombine_keys(self.positions, [0.15, 0.3],
+                                    self.first, self.second)
+        self.assertEqual(keys, [0, 4])
+        keys, r = mr.recombine_keys(self.positions, [0.1, 0.3],
+                                    self.first, self.second)
+        self.assertEqual(keys, [0, 3, 4])
+
+    def testSeveralBreakpointsInOneSegment(self):
+        # An even number of breakpoints between two keys
+        # has no effect, and an odd number is one crossover.
+        for bps in ([0.21, 0.22], [0.21, 0.22, 0.23, 0.24]):
+            keys, r = mr.recombine_keys(self.positions, bps,
+                                        self.first, self.second)
+            self.assertEqual(keys, self.first)
+            self.assertEqual(r, "first")
+        keys, r = mr.recombine_keys(self.positions, [0.21, 0.22, 0.23],
+                                    self.first, self.second)
+        self.assertEqual(keys, [0, 1, 4])
+        self.assertEqual(r, "new")
+
+    def testBreakpointsOutsideKeys(self):
+        keys, r = mr.recombine_keys(self.positions, [0.5],
+                                    self.first, self.second)
+        self.assertEqual(keys, self.first)
+        self.assertEqual(r, "first")
+        keys, r = mr.recombine_keys(self.positions, [0.05],
+                                    self.first, self.second)
+        self.assertEqual(keys, self.second)
+        self.assertEqual(r, "second")
+
+    def testSharedSegments(self):
+        """
+        The result is a parental gamete when the segments
+        taken from the other parent are identical.
+        """
+        positions = [0.1, 0.5, 0.8]
+        keys, r = mr.recombine_keys(positions, [0.3], [0, 1], [0, 2])
+        self.assertEqual(keys, [0, 2])
+        self.assertEqual(r, "second")
+        keys, r = mr.recombine_keys(positions, [0.05, 0.3], [0, 1], [0, 2])
+        self.assertEqual(keys, [0, 1])
+        self.assertEqual(r, "first")
+        keys, r = mr.recombine_keys(positions, [0.6], [0, 1], [0, 2])
+        self.assertEqual(keys, [0, 1, 2])
+        self.assertEqual(r, "new")
+        keys, r = mr.recombine_keys(positions, [0.6], [], [])
+        self.assertEqual(keys, [])
+        self.assertEqual(r, "first")
+
+    def testRandomGametes(self):
+        np.random.seed(101)
+        positions = list(np.random.uniform(0, 1, 200))
+        # Some keys share a position
+        positions += positions[:20]
+        order = sorted(range(len(positions)), key=lambda k: positions[k])
+        for _ in range(200):
+            first = [k for k in order if np.random.uniform() < 0.5]
+            second = [k for k in order if np.random.uniform() < 0.5]
+            # Some breakpoints are at key positions
+            bps = sorted(np.random.choice(positions, 2).tolist()
+                         + np.random.uniform(0, 1,
+                                             np.random.randint(0, 5)).tolist())
+            keys, r = mr.recombine_keys(positions, bps, first, second)
+            self.assertEqual(keys,
+                             naive_recombination(positions, bps,
+                                                 first, second))
+            if r == "first":
+                self.assertEqual(keys, first)
+            elif r == "second":
+                self.assertEqual(keys, second)
+
+
+class testMutateRecombine(unittest.TestCase):
+    def setUp(self):
+        # Keys 0, 1, 4 and 5 are neutral.
+        self.mutations = [(0.1, 0.0), (0.5, 0.0),
+                          (0.2, -0.1), (0.6, -0.1),
+                          (0.3, 0.0), (0.5, 0.0),
+                          (0.5, -0.1), (0.5, -0.2)]
+        # The last gamete is extinct and may be recycled.
+        self.gametes = [(1, [0, 1], [2]),
+                        (1, [1], [2, 3]),
+                        (0, [], [])]
+
+    def run_mr(self, new_mutations, breakpoints, g1, g2):
+        return mr.mutate_recombine(self.mutations, self.gametes,
+                                   new_mutations, breakpoints, g1, g2)
+
+    def testNoRecombinationNoMutation(self):
+        idx, gametes, observed = self.run_mr([], [], 0, 1)
+        self.assertEqual(idx, 0)
+        self.assertEqual(observed, [])
+        self.assertEqual(len(gametes), 3)
+
+    def testSameGamete(self):
+        """
+        Breakpoints are ignored when g1 == g2, and
+        no gamete is created unless there are mutations.
+        """
+        idx, gametes, observed = self.run_mr([], [0.15, 0.55], 1, 1)
+        self.assertEqual(idx, 1)
+        self.assertEqual(observed, [])
+        idx, gametes, observed = self.run_mr([4], [0.15, 0.55], 1, 1)
+        self.assertEqual(idx, 2)
+        self.assertEqual(observed, [2])
+        self.assertEqual(gametes[2], ([4, 1], [2, 3]))
+
+    def testOffspringIsParent(self):
+        """
+        The parental gamete is reused if the recombinant
+        is identical to it, and no new gamete is created.
+        """
+        # Nothing from gamete 0 is inherited
+        idx, gametes, observed = self.run_mr([], [0.05], 0, 1)
+        self.assertEqual(idx, 1)
+        self.assertEqual(observed, [])
+        # The segment from gamete 1 is also in gamete 0
+        idx, gametes, observed = self.run_mr([], [0.35, 0.55], 0, 1)
+        self.assertEqual(idx, 0)
+        self.assertEqual(observed, [])
+        self.assertEqual(gametes, [(g[1], g[2]) for g in self.gametes])
+
+    def testNeutralAndSelectedDisagree(self):
+        """
+        If the neutral keys match one parent and the
+        selected keys match the other, the offspring is new.
+        """
+        idx, gametes, observed = self.run_mr([], [0.15], 0, 1)
+        self.assertEqual(idx, 2)
+        self.assertEqual(observed, [2])
+        self.assertEqual(gametes[2], ([0, 1], [2, 3]))
+
+    def testRecombinant(self):
+        idx, gametes, observed = self.run_mr([], [0.55], 0, 1)
+        self.assertEqual(idx, 2)
+        self.assertEqual(observed, [2])
+        self.assertEqual(gametes[2], ([0, 1], [2, 3]))
+        idx, gametes, observed = self.run_mr([], [0.15], 1, 0)
+        self.assertEqual(idx, 2)
+        self.assertEqual(gametes[2], ([1], [2]))
+
+    def testNewGameteIsAppended(self):
+        self.gametes[2] = (1, [], [])
+        idx, gametes, observed = self.run_mr([4], [], 0, 1)
+        self.assertEqual(idx, 3)
+        self.assertEqual(observed, [3])
+        self.assertEqual(gametes[3], ([0, 4, 1], [2]))
+
+    def testNewMutationsAtTiedPositions(self):
+        """
+        New mutations follow existing keys at the same
+        position, and are kept in the order given.
+        """
+        idx, gametes, observed = self.run_mr([5, 6, 7], [], 0, 1)
+        self.assertEqual(idx, 2)
+        self.assertEqual(observed, [2])
+        self.assertEqual(gametes[2], ([0, 1, 5], [2, 6, 7]))
+        idx, gametes, observed = self.run_mr([5, 6, 7], [0.05], 0, 1)
+        self.assertEqual(gametes[2], ([1, 5], [2, 6, 7, 3]))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,201 @@
+import unittest
+
+import fwdpy11  # NOQA
+import mutation_position_index as mpi
+
+
+def make_index(entries):
+    index = mpi.MutationPositionIndex()
+    for pos, key in entries:
+        index.emplace(pos, key)
+    return index
+
+
+class testDuplicatePositions(unittest.TestCase):
+    def testCount(self):
+        index = make_index([(0.5, i) for i in range(10)] + [(0.25, 10)])
+        self.assertEqual(len(index), 11)
+        self.assertEqual(index.count(0.5), 10)
+        self.assertEqual(index.count(0.25), 1)
+        self.assertEqual(index.count(0.75), 0)
+        self.assertEqual(index.keys_at(0.5), [i for i in range(10)])
+
+    def testEraseByPosition(self):
+        index = make_index([(0.5, i) for i in range(10)] + [(0.25, 10)])
+        self.assertEqual(index.erase(0.5), 10)
+        self.assertEqual(len(index), 1)
+        self.assertEqual(index.count(0.5), 0)
+        self.assertEqual(index.keys_at(0.25), [10])
+
+
+class testEraseDuringEqualRange(unittest.TestCase):
+    def testEraseSome(self):
+        index = make_index([(0.5, i) for i in range(10)])
+        self.assertEqual(index.erase_keys(0.5, [0, 3, 9]), 3)
+        self.assertEqual(len(index), 7)
+        self.assertEqual(index.keys_at(0.5), [1, 2, 4, 5, 6, 7, 8])
+
+    def testEraseAll(self):
+        index = make_index([(0.5, i) for i in range(10)] + [(0.25, 10)])
+        self.assertEqual(index.erase_keys(0.5, [i for i in range(10)]), 10)
+        self.assertEqual(len(index), 1)
+        self.assertEqual(index.count(0.5), 0)
+        self.assertEqual(index.keys_at(0.25), [10])
+
+    def testEraseLast(self):
+        # Removes the final entry of a probe sequence,
+        # which turns its slot back into an empty one.
+        index = make_index([(0.5, 0), (0.5, 1)])
+        self.assertEqual(index.erase_keys(0.5, [1]), 1)
+        self.assertEqual(index.keys_at(0.5), [0])
+        self.assertEqual(index.erase_keys(0.5, [0]), 1)
+        self.assertEqual(len(index), 0)
+        self.assertEqual(index.entries(), [])
+
+
+class testReinsert(unittest.TestCase):
+    def testEraseThenReinsert(self):
+        index = make_index([(0.5, 0), (0.25, 1)])
+        for i in range(100):
+            self.assertEqual(index.erase(0.5), 1)
+            self.assertEqual(index.count(0.5), 0)
+            index.emplace(0.5, i + 2)
+            self.assertEqual(index.keys_at(0.5), [i + 2])
+        self.assertEqual(len(index), 2)
+        self.assertEqual(index.keys_at(0.25), [1])
+
+    def testEraseKeyThenReinsert(self):
+        index = make_index([(0.5, 0), (0.5, 1), (0.5, 2)])
+        self.assertEqual(index.erase_keys(0.5, [1]), 1)
+        index.emplace(0.5, 1)
+        self.assertEqual(index.keys_at(0.5), [0, 1, 2])
+        self.assertEqual(len(index), 3)
+
+
+class testGrowthWithErasedEntries(unittest.TestCase):
+    def testGrowth(self):
+        # Interleave insertions and removals so that the table
+        # grows while it holds markers for erased entries.
+        index = mpi.MutationPositionIndex()
+        expected = {}
+        key = 0
+        for i in range(2000):
+            pos = float(i) / 2000.
+            index.emplace(pos, key)
+            expected[pos] = key
+            key += 1
+            if i % 3 == 0:
+                index.erase_keys(pos, [expected.pop(pos)])
+            if i % 5 == 0 and len(expected) > 0:
+                p = sorted(expected.keys())[0]
+                self.assertEqual(index.erase(p), 1)
+                expected.pop(p)
+        self.assertEqual(len(index), len(expected))
+        self.assertEqual(index.entries(), sorted(expected.items()))
+        for i in range(2000):
+            pos = float(i) / 2000.
+            if pos in expected:
+                self.assertEqual(index.keys_at(pos), [expected[pos]])
+            else:
+                self.assertEqual(index.count(pos), 0)
+
+    def testReserve(self):
+        index = make_index([(float(i), i) for i in range(100)])
+        for i in range(0, 100, 2):
+            index.erase(float(i))
+        index.reserve(10000)
+        self.assertEqual(len(index), 50)
+        self.assertEqual(index.entries(),
+                         [(float(i), i) for i in range(1, 100, 2)])
+
+
+class testEquality(unittest.TestCase):
+    def testInsertionOrder(self):
+        entries = [(0.1, 0), (0.2, 1), (0.1, 2), (0.3, 3)]
+        a = make_index(entries)
+        b = make_index(reversed(entries))
+        self.assertTrue(a == b)
+        self.assertFalse(a != b)
+
+    def testErasedEntries(self):
+        a = make_index([(0.1, 0), (0.2, 1)])
+        b = make_index([(0.1, 0), (0.2, 1), (0.3, 2)])
+        self.assertTrue(a != b)
+        b.erase(0.3)
+        self.assertTrue(a == b)
+
+    def testDifferentKeys(self):
+        a = make_index([(0.1, 0), (0.2, 1)])
+        b = make_index([(0.1, 0), (0.2, 2)])
+        self.assertTrue(a != b)
+
+    def testRepeatedEntries(self):
+        # Same positions and sizes, but the entries
+        # are repeated a different number of times.
+        a = make_index([(0.1, 0), (0.1, 0), (0.1, 1)])
+        b = make_index([(0.1, 0), (0.1, 1), (0.1, 1)])
+        self.assertTrue(a != b)
+        self.assertTrue(a == make_index([(0.1, 1), (0.1, 0), (0.1, 0)]))
+
+    def testEmpty(self):
+        a = mpi.MutationPositionIndex()
+        b = make_index([(0.1, 0)])
+        self.assertTrue(a != b)
+        b.erase(0.1)
+        self.assertTrue(a == b)
+
+
+
+class testSiteIndex(unittest.TestCase):
+    def testDistantSites(self):
+        first = 2**50 + 3
+        index = make_index([(float(first + 1), 0), (0.5, 1), (7.0, 2)])
+        index.index_sites(first, first + 100)
+        self.assertFalse(index.site_occupied(first))
+        self.assertTrue(index.site_occupied(first + 1))
+        self.assertEqual(index.unoccupied_sites(first, first + 100), 99)
+        self.assertEqual(index.unoccupied_site(first, first + 100, 0), first)
+        self.assertEqual(index.unoccupied_site(first, first + 100, 1),
+                         first + 2)
+        index.emplace(float(first + 99), 3)
+        self.assertEqual(index.unoccupied_sites(first, first + 100), 98)
+        index.erase(float(first + 1))
+        self.assertEqual(index.unoccupied_sites(first, first + 100), 99)
+        self.assertEqual(index.unoccupied_site(first, first + 100, 1),
+                         first + 1)
+
+    def testSeveralRanges(self):
+        index = make_index([(5.0, 0), (float(10**12 + 5), 1)])
+        index.index_sites(0, 10)
+        index.index_sites(10**12, 10**12 + 10)
+        self.assertTrue(index.site_occupied(5))
+        self.assertTrue(index.site_occupied(10**12 + 5))
+        self.assertEqual(index.unoccupied_sites(0, 10), 9)
+        self.assertEqual(index.unoccupied_sites(10**12, 10**12 + 10), 9)
+        # Overlaps, and is merged with, the first range
+        index.index_sites(8, 200)
+        index.emplace(150.0, 2)
+        self.assertTrue(index.site_occupied(5))
+        self.assertTrue(index.site_occupied(150))
+        self.assertEqual(index.unoccupied_sites(0, 200), 198)
+        self.assertEqual(index.unoccupied_sites(10**12, 10**12 + 10), 9)
+
+    def testClear(self):
+        index = make_index([(1.0, 0), (2.0, 1)])
+        index.index_sites(0, 10)
+        self.assertEqual(index.unoccupied_sites(0, 10), 8)
+        index.clear()
+        self.assertEqual(index.unoccupied_sites(0, 10), 10)
+        index.emplace(3.0, 0)
+        self.assertEqual(index.unoccupied_sites(0, 10), 9)
+        self.assertTrue(index.site_occupied(3))
+
+    def testSitesNotIndexed(self):
+        index = make_index([(1.0, 0)])
+        index.index_sites(0, 10)
+        with self.assertRaises(IndexError):
+            index.site_occupied(100)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -253,6 +253,69 @@ class testMultivariateGaussianEffects(unittest.TestCase):
             fwdpy11.MultivariateGaussianEffects(0, 1, 1, m)
 
 
+class testSparseMultivariateGaussianEffects(unittest.TestCase):
+    def testConstruction(self):
+        try:
+            fwdpy11.SparseMultivariateGaussianEffects(
+                0, 1, 1, 10, np.array([1, 7]), np.identity(2))
+        except Exception:
+            self.fail("Unexpected exception during object construction")
+
+    def testTraitOutOfRange(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.SparseMultivariateGaussianEffects(
+                0, 1, 1, 10, np.array([1, 10]), np.identity(2))
+
+    def testDuplicateTraits(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.SparseMultivariateGaussianEffects(
+                0, 1, 1, 10, np.array([1, 1]), np.identity(2))
+
+    def testWrongNumberOfTraits(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.SparseMultivariateGaussianEffects(
+                0, 1, 1, 10, np.array([1, 2, 3]), np.identity(2))
+
+    def testPickling(self):
+        r = fwdpy11.SparseMultivariateGaussianEffects(
+            BEG, END, WEIGHT, 10, np.array([3, 5]), np.identity(2),
+            -0.3, DOM, COUPLED, LABEL)
+        up = pickle.loads(pickle.dumps(r, -1))
+        self.assertEqual(r, up)
+
+    def testSimulation(self):
+        N, ndim = 500, 50
+        regions = [fwdpy11.SparseMultivariateGaussianEffects(
+            i, i + 1, 1, ndim, np.array([i, (i + 1) % ndim]),
+            np.identity(2) * 0.1) for i in range(5)]
+        gv2w = fwdpy11.MultivariateGSS(np.zeros(ndim), 1.0)
+        p = {'nregions': [],
+             'sregions': regions,
+             'recregions': [fwdpy11.Region(0, 5, 1)],
+             'rates': (0.0, 5e-3, 1e-3),
+             'gvalue': fwdpy11.StrictAdditiveMultivariateEffects(
+                 ndim, 0, gv2w),
+             'prune_selected': False,
+             'demography': np.array([N] * 20, dtype=np.uint32)
+             }
+        params = fwdpy11.ModelParams(**p)
+        pop = fwdpy11.DiploidPopulation(N, 5.0)
+        fwdpy11.evolvets(fwdpy11.GSLrng(42), pop, params, 10,
+                         record_gvalue_matrix=True)
+        for m in pop.mutations:
+            i = int(m.pos)
+            self.assertEqual(len(m.esizes), ndim)
+            nonzero = np.where(np.array(m.esizes) != 0.0)[0]
+            self.assertTrue(set(nonzero).issubset({i, (i + 1) % ndim}))
+        gv = pop.genetic_values
+        for i, dip in enumerate(pop.diploids):
+            expected = np.zeros(ndim)
+            for g in [dip.first, dip.second]:
+                for k in pop.haploid_genomes[g].smutations:
+                    expected += np.array(pop.mutations[k].esizes)
+            self.assertTrue(np.allclose(gv[i, :], expected))
+
+
 class test_PickleMultivariateGaussianEffects(unittest.TestCase):
     @classmethod
     def setUp(self):
@@ -292,6 +355,330 @@ class testPoissonInterval(unittest.TestCase):
         self.assertEqual(up.mean, self.pi.mean)
 
 
+class testRecombinationRateMap(unittest.TestCase):
+    @classmethod
+    def setUp(self):
+        self.positions = [0., 10., 20., 50.]
+        self.rates = [1e-2, 0., 2e-2]
+        self.rm = fwdpy11.RecombinationRateMap(self.positions, self.rates)
+
+    def test_total(self):
+        self.assertAlmostEqual(self.rm.total, 0.1 + 0.6)
+
+    def test_pickling(self):
+        up = pickle.loads(pickle.dumps(self.rm))
+        self.assertEqual(up.positions, self.positions)
+        self.assertEqual(up.rates, self.rates)
+
+    def test_bad_input(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.RecombinationRateMap([0., 1.], [1., 1.])
+        with self.assertRaises(ValueError):
+            fwdpy11.RecombinationRateMap([0., 1., 1.], [1., 1.])
+        with self.assertRaises(ValueError):
+            fwdpy11.RecombinationRateMap([0., 1.], [-1.])
+        with self.assertRaises(ValueError):
+            fwdpy11.RecombinationRateMap([0., np.nan], [1.])
+
+    def test_from_hapmap(self):
+        import os
+        import tempfile
+        fd, fname = tempfile.mkstemp()
+        with os.fdopen(fd, 'w') as f:
+            f.write("Chromosome\tPosition(bp)\tRate(cM/Mb)\tMap(cM)\n")
+            f.write("chr22\t1000\t2.0\t0.0\n")
+            f.write("chr22\t2000\t0.5\t0.002\n")
+            f.write("chr22\t4000\t0.0\t0.003\n")
+        try:
+            rm = fwdpy11.RecombinationRateMap.from_hapmap(fname, 10.0)
+        finally:
+            os.remove(fname)
+        self.assertEqual(rm.positions, [1000., 2000., 4000.])
+        self.assertEqual(len(rm.rates), 2)
+        self.assertAlmostEqual(rm.rates[0], 2e-7)
+        self.assertAlmostEqual(rm.rates[1], 5e-8)
+
+    def test_missing_file(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.RecombinationRateMap.from_hapmap("/no/such/file")
+
+    def test_evolve(self):
+        N = 100
+        rm = fwdpy11.RecombinationRateMap([0., 0.5, 1.], [2., 0.])
+        # evolvets does not accept neutral regions, and
+        # mutations are not needed to check the trees.
+        p = {'nregions': [],
+             'sregions': [],
+             'recregions': [rm],
+             'rates': (0.0, 0.0, None),
+             'gvalue': fwdpy11.Multiplicative(2.0),
+             'prune_selected': False,
+             'demography': np.array([N] * 100, dtype=np.uint32)
+             }
+        pop = fwdpy11.DiploidPopulation(N, 1.0)
+        fwdpy11.evolvets(fwdpy11.GSLrng(42), pop,
+                         fwdpy11.ModelParams(**p), 100)
+        # No crossovers happen in [0.5, 1), so all trees there
+        # share the same interval
+        left = [t.left for t in fwdpy11.TreeIterator(pop.tables,
+                                                    [i for i in
+                                                     range(2 * N)])]
+        self.assertTrue(all(x <= 0.5 for x in left))
+
+
+class testMutationIntervalMap(unittest.TestCase):
+    @classmethod
+    def setUp(self):
+        self.dfe = [fwdpy11.ConstantS(0, 1, 1, -0.1, label=1),
+                    fwdpy11.ExpS(0, 1, 1, 0.05, label=2)]
+        self.mm = fwdpy11.MutationIntervalMap([20., 0., 50.],
+                                              [30., 10., 60.],
+                                              [1., 2., 0.],
+                                              [1, 0, 0], self.dfe)
+
+    def test_sorted(self):
+        self.assertEqual(self.mm.starts, [0., 20., 50.])
+        self.assertEqual(self.mm.stops, [10., 30., 60.])
+        self.assertEqual(self.mm.rates, [2., 1., 0.])
+        self.assertEqual(self.mm.classes, [0, 1, 0])
+
+    def test_weight(self):
+        self.assertAlmostEqual(self.mm.total, 30.)
+        self.assertAlmostEqual(self.mm.w, 30.)
+        self.assertEqual(self.mm.b, 0.)
+        self.assertEqual(self.mm.e, 60.)
+
+    def test_pickling(self):
+        up = pickle.loads(pickle.dumps(self.mm))
+        self.assertEqual(up.starts, self.mm.starts)
+        self.assertEqual(up.stops, self.mm.stops)
+        self.assertEqual(up.rates, self.mm.rates)
+        self.assertEqual(up.classes, self.mm.classes)
+        self.assertEqual([type(i) for i in up.dfe],
+                         [type(i) for i in self.dfe])
+        self.assertEqual(up.dfe[0].s, self.dfe[0].s)
+
+    def test_bad_input(self):
+        with self.assertRaises(ValueError):
+            # overlap
+            fwdpy11.MutationIntervalMap([0., 5.], [10., 15.], [1., 1.],
+                                        [0, 0], self.dfe)
+        with self.assertRaises(ValueError):
+            # class out of range
+            fwdpy11.MutationIntervalMap([0.], [10.], [1.], [2], self.dfe)
+        with self.assertRaises(ValueError):
+            fwdpy11.MutationIntervalMap([0.], [10.], [-1.], [0], self.dfe)
+        with self.assertRaises(ValueError):
+            fwdpy11.MutationIntervalMap([0.], [10.], [0.], [0], self.dfe)
+        with self.assertRaises(ValueError):
+            fwdpy11.MutationIntervalMap([10.], [0.], [1.], [0], self.dfe)
+        with self.assertRaises(ValueError):
+            fwdpy11.MutationIntervalMap([0.], [10.], [1., 1.], [0],
+                                        self.dfe)
+        with self.assertRaises(ValueError):
+            fwdpy11.MutationIntervalMap([0.], [10.], [1.], [0], [self.mm])
+        with self.assertRaises(ValueError):
+            fwdpy11.MutationIntervalMap(
+                [0.], [10.], [1.], [0],
+                [fwdpy11.FiniteSites(fwdpy11.Region(0, 10, 1))])
+
+    def test_from_bed(self):
+        import os
+        import tempfile
+        fd, fname = tempfile.mkstemp()
+        with os.fdopen(fd, 'w') as f:
+            f.write("track name=exons\n")
+            f.write("# comment\n")
+            f.write("chr1\t100\t200\n")
+            f.write("chr1\t0\t50\t0.5\t1\textra\n")
+            f.write("\n")
+        try:
+            mm = fwdpy11.MutationIntervalMap.from_bed(fname, self.dfe)
+        finally:
+            os.remove(fname)
+        self.assertEqual(mm.starts, [0., 100.])
+        self.assertEqual(mm.stops, [50., 200.])
+        self.assertEqual(mm.rates, [0.5, 1.])
+        self.assertEqual(mm.classes, [1, 0])
+
+    def test_from_bed_two_chromosomes(self):
+        import os
+        import tempfile
+        fd, fname = tempfile.mkstemp()
+        with os.fdopen(fd, 'w') as f:
+            f.write("chr1\t100\t200\n")
+            f.write("chr2\t0\t50\n")
+        try:
+            with self.assertRaises(ValueError):
+                fwdpy11.MutationIntervalMap.from_bed(fname, self.dfe)
+        finally:
+            os.remove(fname)
+
+    def test_evolve(self):
+        N = 100
+        p = {'nregions': [],
+             'sregions': [self.mm],
+             'recregions': [fwdpy11.PoissonInterval(0, 60, 1e-2)],
+             'rates': (0.0, 5e-2, None),
+             'gvalue': fwdpy11.Multiplicative(2.0),
+             'prune_selected': False,
+             'demography': np.array([N] * 20, dtype=np.uint32)
+             }
+        pop = fwdpy11.DiploidPopulation(N, 60.0)
+        fwdpy11.evolve_genomes(fwdpy11.GSLrng(42), pop,
+                               fwdpy11.ModelParams(**p))
+        self.assertTrue(len(pop.mutations) > 0)
+        for m in pop.mutations:
+            if m.label == 1:
+                self.assertTrue(20. <= m.pos < 30.)
+                self.assertEqual(m.s, -0.1)
+            else:
+                self.assertEqual(m.label, 2)
+                self.assertTrue(0. <= m.pos < 10.)
+                self.assertTrue(m.s > 0.0)
+
+
+class testFiniteSites(unittest.TestCase):
+    @classmethod
+    def setUp(self):
+        self.fs = fwdpy11.FiniteSites(fwdpy11.ConstantS(10, 1010, 1, -0.01,
+                                                        label=3))
+
+    def test_properties(self):
+        self.assertEqual(self.fs.b, 10)
+        self.assertEqual(self.fs.e, 1010)
+        self.assertEqual(self.fs.w, 1000)
+        self.assertEqual(self.fs.l, 3)
+        self.assertFalse(self.fs.recurrent)
+        self.assertEqual(self.fs.dfe.s, -0.01)
+
+    def test_pickling(self):
+        fs = fwdpy11.FiniteSites(fwdpy11.Region(0, 10, 1), True)
+        up = pickle.loads(pickle.dumps(fs))
+        self.assertTrue(up.recurrent)
+        self.assertEqual(up.b, fs.b)
+        self.assertEqual(up.e, fs.e)
+        self.assertEqual(up.dfe.s, 0.0)
+
+    def test_bad_input(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.FiniteSites(fwdpy11.ConstantS(0.5, 10, 1, -0.01))
+        with self.assertRaises(ValueError):
+            fwdpy11.FiniteSites(fwdpy11.ConstantS(-1, 10, 1, -0.01))
+        with self.assertRaises(ValueError):
+            fwdpy11.FiniteSites(self.fs)
+        with self.assertRaises(ValueError):
+            fwdpy11.FiniteSites(fwdpy11.MutationIntervalMap(
+                [0.], [10.], [1.], [0], [fwdpy11.ExpS(0, 1, 1, 0.1)]))
+
+    def test_dfe_types(self):
+        """
+        Every distribution of effect sizes generates
+        mutations at the sites chosen by FiniteSites.
+        """
+        dfe = [fwdpy11.ConstantS(0, 1000, 1, -0.01),
+               fwdpy11.ExpS(0, 1000, 1, -0.01),
+               fwdpy11.GammaS(0, 1000, 1, -0.01, 0.5),
+               fwdpy11.GaussianS(0, 1000, 1, 0.01),
+               fwdpy11.UniformS(0, 1000, 1, -0.01, 0.01),
+               fwdpy11.MultivariateGaussianEffects(0, 1000, 1,
+                                                   np.identity(2)),
+               fwdpy11.SparseMultivariateGaussianEffects(
+                   0, 1000, 1, 4, np.array([1, 3]), np.identity(2))]
+        for d in dfe:
+            pop = self.evolve([fwdpy11.FiniteSites(d)], 1e-2, L=1000.0)
+            self.assertTrue(len(pop.mutations) > 0)
+            for m in pop.mutations:
+                self.assertEqual(m.pos, int(m.pos))
+                self.assertTrue(0 <= m.pos < 1000)
+
+    def evolve(self, sregions, mu, N=100, L=1010.0, nregions=[], mu_n=0.0):
+        p = {'nregions': nregions,
+             'sregions': sregions,
+             'recregions': [fwdpy11.PoissonInterval(0, L, 1e-2)],
+             'rates': (mu_n, mu, None),
+             'gvalue': fwdpy11.Multiplicative(2.0),
+             'prune_selected': False,
+             'demography': np.array([N] * 50, dtype=np.uint32)
+             }
+        pop = fwdpy11.DiploidPopulation(N, L)
+        fwdpy11.evolve_genomes(fwdpy11.GSLrng(42), pop,
+                               fwdpy11.ModelParams(**p))
+        return pop
+
+    def test_evolve_distant_sites(self):
+        """
+        The sites are tracked relative to the start of
+        the region, so distant regions need little memory.
+        """
+        beg = 2.0**50
+        fs = fwdpy11.FiniteSites(fwdpy11.ConstantS(beg, beg + 100, 1, -0.01))
+        fs2 = fwdpy11.FiniteSites(fwdpy11.ConstantS(10, 1010, 1, -0.01))
+        pop = self.evolve([fs, fs2], 0.1, L=beg + 100)
+        extant = [m.pos for m, c in zip(pop.mutations, pop.mcounts) if c > 0]
+        self.assertTrue(any(p >= beg for p in extant))
+        self.assertTrue(any(p < 1010 for p in extant))
+        self.assertEqual(len(extant), len(set(extant)))
+        for p in extant:
+            self.assertEqual(p, int(p))
+            self.assertTrue(10 <= p < 1010 or beg <= p < beg + 100)
+
+    def test_evolve_neutral(self):
+        fs = fwdpy11.FiniteSites(fwdpy11.Region(10, 1010, 1))
+        pop = self.evolve([], 0.0, nregions=[fs], mu_n=0.1)
+        extant = [m for m, c in zip(pop.mutations, pop.mcounts) if c > 0]
+        self.assertTrue(len(extant) > 0)
+        self.assertEqual(len(extant), len(set(m.pos for m in extant)))
+        for m in extant:
+            self.assertTrue(m.neutral)
+            self.assertEqual(m.pos, int(m.pos))
+            self.assertTrue(10 <= m.pos < 1010)
+
+    def test_selected_sites_in_neutral_regions(self):
+        with self.assertRaises(ValueError):
+            self.evolve([], 0.0, nregions=[self.fs], mu_n=0.1)
+
+    def test_evolve(self):
+        pop = self.evolve([self.fs], 0.5)
+        extant = [m.pos for m, c in zip(pop.mutations, pop.mcounts) if c > 0]
+        self.assertTrue(len(extant) > 0)
+        self.assertEqual(len(extant), len(set(extant)))
+        for p in extant:
+            self.assertEqual(p, int(p))
+            self.assertTrue(10 <= p < 1010)
+
+    def test_evolve_recurrent(self):
+        fs = fwdpy11.FiniteSites(fwdpy11.ConstantS(0, 2, 1, -0.01), True)
+        pop = self.evolve([fs], 0.5)
+        extant = [m.pos for m, c in zip(pop.mutations, pop.mcounts) if c > 0]
+        self.assertTrue(len(extant) > 2)
+        self.assertTrue(set(extant) <= set([0., 1.]))
+        for p in set(extant):
+            self.assertEqual(sorted(pop.mutation_indexes(p)),
+                             sorted(i for i, m in enumerate(pop.mutations)
+                                    if m.pos == p and pop.mcounts[i] > 0))
+
+    def test_all_sites_occupied(self):
+        fs = fwdpy11.FiniteSites(fwdpy11.ConstantS(0, 2, 1, -0.01))
+        with self.assertRaises(RuntimeError):
+            self.evolve([fs], 0.5)
+
+    def test_evolvets_recurrent(self):
+        fs = fwdpy11.FiniteSites(fwdpy11.ConstantS(0, 2, 1, -0.01), True)
+        p = {'nregions': [],
+             'sregions': [fs],
+             'recregions': [],
+             'rates': (0.0, 1e-3, None),
+             'gvalue': fwdpy11.Multiplicative(2.0),
+             'prune_selected': False,
+             'demography': np.array([10] * 2, dtype=np.uint32)
+             }
+        pop = fwdpy11.DiploidPopulation(10, 2.0)
+        with self.assertRaises(ValueError):
+            fwdpy11.evolvets(fwdpy11.GSLrng(42), pop,
+                             fwdpy11.ModelParams(**p), 100)
+
+
 class testFixedCrossovers(unittest.TestCase):
     @classmethod
     def setUp(self):
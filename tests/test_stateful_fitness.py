@@ -5,6 +5,7 @@ import fwdpy11 as fp11
 import fwdpy11
 import fwdpy11.ezparams
 import snowdrift
+import frequency_dependent
 
 
 class SamplePhenotypes(object):
@@ -80,5 +81,31 @@ class testSnowdrift(unittest.TestCase):
         p
 
 
+class testPopulationAggregate(unittest.TestCase):
+    @classmethod
+    def setUp(self):
+        self.N = 500
+        p = {'sregions': [fp11.GaussianS(0, 1, 1, 0.1)],
+             'recregions': [fp11.Region(0, 1, 1)],
+             'nregions': [],
+             'gvalue': frequency_dependent.MeanRelativeFitness(1.0),
+             'demography': np.array([self.N] * 50, dtype=np.uint32),
+             'rates': (0.0, 0.005, 0.001),
+             'prune_selected': False
+             }
+        self.params = fwdpy11.ModelParams(**p)
+        self.pop = fp11.DiploidPopulation(self.N)
+
+    def test_evolve(self):
+        fp11.evolve_genomes(fp11.GSLrng(42), self.pop, self.params)
+        gv = self.params.gvalue
+        self.assertEqual(gv.individuals_seen, self.N)
+        g = np.array([md.g for md in self.pop.diploid_metadata])
+        self.assertAlmostEqual(gv.mean_genetic_value, g.mean())
+        for md in self.pop.diploid_metadata:
+            self.assertAlmostEqual(md.w,
+                                   np.exp(-(md.g - g.mean())**2 / 2.0))
+
+
 if __name__ == "__main__":
     unittest.main()
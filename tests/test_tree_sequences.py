@@ -519,5 +519,322 @@ class testMetaData(unittest.TestCase):
             self.assertAlmostEqual(i, j)
 
 
+
+class testNodeGeneticValues(unittest.TestCase):
+    """
+    Genetic values of alive and ancient nodes
+    obtained from a single pass over the trees.
+    """
+    @classmethod
+    def setUpClass(self):
+        N = 500
+        a = fwdpy11.Additive(2.0, fwdpy11.GSS(VS=1, opt=1))
+        p = {'nregions': [],
+             'sregions': [fwdpy11.GaussianS(0, 1, 1, 0.25)],
+             'recregions': [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+             'rates': (0.0, 0.005, None),
+             'gvalue': a,
+             'prune_selected': False,
+             'demography': np.array([N]*2*N, dtype=np.uint32)
+             }
+        params = fwdpy11.ModelParams(**p)
+        self.pop = fwdpy11.DiploidPopulation(N, 1.0)
+
+        class Recorder(object):
+            def __call__(self, pop, recorder):
+                if pop.generation % 250 == 0.0:
+                    recorder.assign(np.arange(10, dtype=np.int32))
+
+        fwdpy11.evolvets(fwdpy11.GSLrng(1010), self.pop, params, 100,
+                         Recorder())
+        self.metadata = [i for i in self.pop.diploid_metadata] + \
+            [i for i in self.pop.ancient_sample_metadata]
+        self.samples = []
+        for md in self.metadata:
+            self.samples.extend(md.nodes)
+
+    def testMatchesSimulation(self):
+        self.assertTrue(len(self.pop.ancient_sample_metadata) > 0)
+        gv = fwdpy11.node_genetic_values(self.pop, self.samples)
+        self.assertEqual(len(gv), len(self.samples))
+        for i, md in enumerate(self.metadata):
+            self.assertAlmostEqual(md.g, gv[2*i] + gv[2*i + 1])
+
+    def testThreads(self):
+        gv = fwdpy11.node_genetic_values(self.pop, self.samples)
+        for nthreads in [2, 5]:
+            gvt = fwdpy11.node_genetic_values(self.pop, self.samples,
+                                              nthreads=nthreads)
+            self.assertTrue(np.allclose(gv, gvt))
+
+    def testSampleOrder(self):
+        """
+        Rows follow the order of the samples,
+        not the order of the node IDs.
+        """
+        gv = fwdpy11.node_genetic_values(self.pop, self.samples)
+        for nthreads in [1, 3]:
+            gvr = fwdpy11.node_genetic_values(self.pop, self.samples[::-1],
+                                              nthreads=nthreads)
+            self.assertTrue(np.allclose(gv[::-1], gvr))
+
+    def testInvalidInput(self):
+        with self.assertRaises(ValueError):
+            fwdpy11.node_genetic_values(self.pop, [])
+        with self.assertRaises(ValueError):
+            fwdpy11.node_genetic_values(self.pop, self.samples, nthreads=0)
+        # Mutations have no vector effects
+        with self.assertRaises(ValueError):
+            fwdpy11.node_genetic_values(self.pop, self.samples, ndim=2)
+
+
+class testEvolveIter(unittest.TestCase):
+    @classmethod
+    def setUp(self):
+        self.N = 500
+        self.demography = np.array([self.N]*95, dtype=np.uint32)
+        GSS = fwdpy11.GSS(VS=1, opt=0)
+        a = fwdpy11.Additive(2.0, GSS)
+        self.p = {'nregions': [],
+                  'sregions': [fwdpy11.GaussianS(0, 1, 1, 0.25)],
+                  'recregions': [fwdpy11.Region(0, 1, 1)],
+                  'rates': (0.0, 0.025, 1e-3),
+                  'gvalue': a,
+                  'prune_selected': False,
+                  'demography': self.demography
+                  }
+        self.params = fwdpy11.ModelParams(**self.p)
+
+    def testSameResultAsEvolvets(self):
+        rng = fwdpy11.GSLrng(42)
+        pop = fwdpy11.DiploidPopulation(self.N, 1.0)
+        fwdpy11.evolvets(rng, pop, self.params, 50)
+
+        rng_iter = fwdpy11.GSLrng(42)
+        pop_iter = fwdpy11.DiploidPopulation(self.N, 1.0)
+        generations = []
+        for p in fwdpy11.evolve_iter(rng_iter, pop_iter, self.params, 50,
+                                     every=10):
+            generations.append(p.generation)
+        self.assertEqual(generations, [10*i for i in range(1, 10)] + [95])
+        self.assertEqual(pop.generation, pop_iter.generation)
+        for i, j in zip(pop.diploid_metadata, pop_iter.diploid_metadata):
+            self.assertEqual(i.g, j.g)
+        extant = sorted((m.pos, c) for m, c in zip(pop.mutations, pop.mcounts)
+                        if c > 0)
+        extant_iter = sorted((m.pos, c) for m, c in zip(pop_iter.mutations,
+                                                        pop_iter.mcounts)
+                             if c > 0)
+        self.assertEqual(extant, extant_iter)
+
+    def testMutationCountsWithoutSimplification(self):
+        rng = fwdpy11.GSLrng(42)
+        pop = fwdpy11.DiploidPopulation(self.N, 1.0)
+        for p in fwdpy11.evolve_iter(rng, pop, self.params, 50, every=7,
+                                     simplify=False):
+            mcounts = np.zeros(len(p.mutations), dtype=np.uint32)
+            for d in p.diploids:
+                for g in (d.first, d.second):
+                    for k in p.haploid_genomes[g].smutations:
+                        mcounts[k] += 1
+            self.assertTrue(np.array_equal(mcounts, np.array(p.mcounts)))
+
+    def testInvalidEvery(self):
+        rng = fwdpy11.GSLrng(42)
+        pop = fwdpy11.DiploidPopulation(self.N, 1.0)
+        with self.assertRaises(ValueError):
+            for p in fwdpy11.evolve_iter(rng, pop, self.params, 50, every=0):
+                pass
+
+
+class testNodeTableCapacity(unittest.TestCase):
+    """
+    Lowers the largest node ID so that the
+    handling of a full node table can be tested.
+    """
+    @classmethod
+    def setUp(self):
+        self.N = 100
+        self.demography = np.array([self.N]*50, dtype=np.uint32)
+        GSS = fwdpy11.GSS(VS=1, opt=0)
+        a = fwdpy11.Additive(2.0, GSS)
+        self.p = {'nregions': [],
+                  'sregions': [fwdpy11.GaussianS(0, 1, 1, 0.25)],
+                  'recregions': [fwdpy11.Region(0, 1, 1)],
+                  'rates': (0.0, 0.025, 1e-3),
+                  'gvalue': a,
+                  'prune_selected': False,
+                  'demography': self.demography
+                  }
+        self.params = fwdpy11.ModelParams(**self.p)
+
+    def run_with_state(self, rng, pop, state):
+        from fwdpy11._evolvets import _evolvets_setup
+        from fwdpy11._fwdpy11 import evolve_with_tree_sequences
+        recorder, stopping_criterion, mm, rm, nthreads = _evolvets_setup(
+            self.params, None, None, None)
+        evolve_with_tree_sequences(rng, pop, fwdpy11.SampleRecorder(),
+                                   1000, self.params.demography,
+                                   self.params.mutrate_s, mm, rm,
+                                   self.params.gvalue, recorder,
+                                   stopping_criterion, self.params.pself,
+                                   True, False, False, False, True, 0.0,
+                                   nthreads, state,
+                                   len(self.params.demography), False)
+
+    def testDefault(self):
+        state = fwdpy11._fwdpy11._TreeSequenceEvolutionState()
+        self.assertEqual(state._max_node_id, np.iinfo(np.int32).max)
+        with self.assertRaises(ValueError):
+            state._max_node_id = -1
+        with self.assertRaises(ValueError):
+            state._max_node_id = np.iinfo(np.int32).max + 1
+
+    def testSimplifyEarly(self):
+        """
+        The simplification interval exceeds the number of
+        generations, so the run only completes if the tables
+        are simplified when the next generation would not fit.
+        The outcome is the same as without the limit.
+        """
+        rng = fwdpy11.GSLrng(42)
+        pop = fwdpy11.DiploidPopulation(self.N, 1.0)
+        self.run_with_state(rng, pop,
+                            fwdpy11._fwdpy11._TreeSequenceEvolutionState())
+
+        state = fwdpy11._fwdpy11._TreeSequenceEvolutionState()
+        state._max_node_id = 20 * self.N
+        rng_limited = fwdpy11.GSLrng(42)
+        pop_limited = fwdpy11.DiploidPopulation(self.N, 1.0)
+        self.run_with_state(rng_limited, pop_limited, state)
+        self.assertEqual(pop.generation, pop_limited.generation)
+        for i, j in zip(pop.diploid_metadata, pop_limited.diploid_metadata):
+            self.assertEqual(i.g, j.g)
+            self.assertEqual(i.w, j.w)
+        self.assertEqual(len(pop.tables.nodes), len(pop_limited.tables.nodes))
+
+    def testOverflow(self):
+        """
+        The nodes of the parents and of the offspring
+        cannot both be stored, even after simplification.
+        """
+        state = fwdpy11._fwdpy11._TreeSequenceEvolutionState()
+        state._max_node_id = 3 * self.N
+        rng = fwdpy11.GSLrng(42)
+        pop = fwdpy11.DiploidPopulation(self.N, 1.0)
+        with self.assertRaises(OverflowError):
+            self.run_with_state(rng, pop, state)
+
+
+class testSpecializedGenerationLoops(unittest.TestCase):
+    """
+    Models with no recombination, no mutation, or a selfing
+    rate of 0 or 1 use specialized generation loops.  For
+    a given seed, they must give the same output as the
+    generic loop.
+    """
+    @classmethod
+    def setUp(self):
+        self.N = 100
+        self.demography = np.array([self.N]*100, dtype=np.uint32)
+
+    def make_params(self, recregions, recrate, mutrate, pself):
+        GSS = fwdpy11.GSS(VS=1, opt=0)
+        a = fwdpy11.Additive(2.0, GSS)
+        p = {'nregions': [],
+             'sregions': [fwdpy11.GaussianS(0, 1, 1, 0.25)],
+             'recregions': recregions,
+             'rates': (0.0, mutrate, recrate),
+             'gvalue': a,
+             'prune_selected': False,
+             'demography': self.demography,
+             'pself': pself
+             }
+        return fwdpy11.ModelParams(**p)
+
+    def run(self, params, generic):
+        from fwdpy11._evolvets import _evolvets_setup
+        from fwdpy11._fwdpy11 import evolve_with_tree_sequences
+        state = fwdpy11._fwdpy11._TreeSequenceEvolutionState()
+        state._generic_generation_loop = generic
+        rng = fwdpy11.GSLrng(101)
+        pop = fwdpy11.DiploidPopulation(self.N, 1.0)
+        recorder, stopping_criterion, mm, rm, nthreads = _evolvets_setup(
+            params, None, None, None)
+        evolve_with_tree_sequences(rng, pop, fwdpy11.SampleRecorder(),
+                                   10, params.demography,
+                                   params.mutrate_s, mm, rm,
+                                   params.gvalue, recorder,
+                                   stopping_criterion, params.pself,
+                                   True, False, False, False, True, 0.0,
+                                   nthreads, state,
+                                   len(params.demography), False)
+        return pop
+
+    def compare(self, params):
+        pop = self.run(params, False)
+        generic = self.run(params, True)
+        self.assertTrue(pop.tables == generic.tables)
+        self.assertEqual(len(pop.mutations), len(generic.mutations))
+        for i, j in zip(pop.mutations, generic.mutations):
+            self.assertEqual(i.pos, j.pos)
+            self.assertEqual(i.s, j.s)
+        for i, j in zip(pop.diploid_metadata, generic.diploid_metadata):
+            self.assertEqual(i.parents, j.parents)
+            self.assertEqual(i.g, j.g)
+            self.assertEqual(i.w, j.w)
+        return pop
+
+    def testRecombination(self):
+        self.compare(self.make_params(
+            [fwdpy11.Region(0, 1, 1)], 1e-2, 1e-2, 0.0))
+
+    def testNoRecombination(self):
+        pop = self.compare(self.make_params(
+            [fwdpy11.Region(0, 1, 1)], 0.0, 1e-2, 0.0))
+        self.assertTrue(len(pop.mutations) > 0)
+        for e in pop.tables.edges:
+            self.assertEqual(e.left, 0.0)
+            self.assertEqual(e.right, 1.0)
+
+    def testNoRecombinationGeneralizedMap(self):
+        """
+        Maps whose units all have zero rates
+        count as having no recombination.
+        """
+        units = [fwdpy11.RecombinationRateMap([0., 0.5, 1.], [0., 0.]),
+                 fwdpy11.PoissonInterval(0, 1, 0.),
+                 fwdpy11.PoissonPoint(0.5, 0.),
+                 fwdpy11.BinomialPoint(0.5, 0.),
+                 fwdpy11.FixedCrossovers(0, 1, 0)]
+        pop = self.compare(self.make_params(units, None, 1e-2, 0.0))
+        for e in pop.tables.edges:
+            self.assertEqual(e.left, 0.0)
+            self.assertEqual(e.right, 1.0)
+
+    def testNoMutation(self):
+        pop = self.compare(self.make_params(
+            [fwdpy11.Region(0, 1, 1)], 1e-2, 0.0, 0.0))
+        self.assertEqual(len(pop.mutations), 0)
+
+    def testNoRecombinationNoMutation(self):
+        self.compare(self.make_params(
+            [fwdpy11.Region(0, 1, 1)], 0.0, 0.0, 0.0))
+
+    def testSelfing(self):
+        pop = self.compare(self.make_params(
+            [fwdpy11.Region(0, 1, 1)], 1e-2, 1e-2, 1.0))
+        for md in pop.diploid_metadata:
+            self.assertEqual(md.parents[0], md.parents[1])
+
+    def testPartialSelfing(self):
+        self.compare(self.make_params(
+            [fwdpy11.Region(0, 1, 1)], 1e-2, 1e-2, 0.5))
+
+    def testSelfingNoRecombinationNoMutation(self):
+        self.compare(self.make_params(
+            [fwdpy11.Region(0, 1, 1)], 0.0, 0.0, 1.0))
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -90,5 +90,71 @@ class test_ChangeEsizeDiploid(unittest.TestCase):
         self.assertEqual(self.pop.mutations[extant[0][0]].esizes[0], 0.0)
         self.assertEqual(self.pop.mutations[extant[0][0]].heffects[0], -1.0)
 
+
+class test_ChangeEsizesBatch(unittest.TestCase):
+    @classmethod
+    def setUp(self):
+        self.pop = quick_neutral_slocus()
+        self.pop2 = quick_neutral_slocus()
+
+    def test_same_as_one_at_a_time(self):
+        import numpy as np
+        extant = np.array([i for i, c in enumerate(self.pop.mcounts)
+                           if c > 0][:10], dtype=np.uint64)
+        s = np.array([-0.1 * (i % 2) for i in range(len(extant))])
+        h = np.array([0.5] * len(extant))
+        fwdpy11.change_effect_sizes(self.pop, extant, s, h)
+        for i, j, k in zip(extant, s, h):
+            fwdpy11.change_effect_size(self.pop2, int(i), j, k)
+        for i in extant:
+            self.assertEqual(self.pop.mutations[i].s,
+                             self.pop2.mutations[i].s)
+            self.assertEqual(self.pop.mutations[i].neutral,
+                             self.pop2.mutations[i].neutral)
+        for a, b in zip(self.pop.haploid_genomes, self.pop2.haploid_genomes):
+            if a.n > 0:
+                self.assertEqual(list(a.mutations), list(b.mutations))
+                self.assertEqual(list(a.smutations), list(b.smutations))
+
+        # Back to neutral
+        fwdpy11.change_effect_sizes(self.pop, extant,
+                                    np.zeros(len(extant)), h)
+        for i in extant:
+            self.assertEqual(self.pop.mutations[i].neutral, True)
+        for g in self.pop.haploid_genomes:
+            if g.n > 0:
+                self.assertEqual(len(g.smutations), 0)
+
+    def test_vector_effects(self):
+        import numpy as np
+        extant = np.array([i for i, c in enumerate(self.pop.mcounts)
+                           if c > 0][:2], dtype=np.uint64)
+        esizes = np.array([[1.0, 0.0], [0.0, 0.0]])
+        heffects = np.ones(4).reshape(2, 2)
+        fwdpy11.change_effect_sizes(self.pop, extant, np.zeros(2),
+                                    np.ones(2), esizes, heffects)
+        self.assertEqual(self.pop.mutations[extant[0]].neutral, False)
+        self.assertEqual(list(self.pop.mutations[extant[0]].esizes),
+                         [1.0, 0.0])
+        self.assertEqual(self.pop.mutations[extant[1]].neutral, True)
+
+    def test_invalid_input(self):
+        import numpy as np
+        extant = np.array([i for i, c in enumerate(self.pop.mcounts)
+                           if c > 0][:2], dtype=np.uint64)
+        with self.assertRaises(ValueError):
+            fwdpy11.change_effect_sizes(self.pop, extant, np.zeros(1),
+                                        np.ones(2))
+        with self.assertRaises(ValueError):
+            fwdpy11.change_effect_sizes(self.pop, np.array([extant[0]] * 2),
+                                        np.array([-0.1, -0.1]), np.ones(2))
+        with self.assertRaises(ValueError):
+            fwdpy11.change_effect_sizes(self.pop, extant,
+                                        np.array([np.nan, -0.1]), np.ones(2))
+        # Nothing was changed
+        for i in extant:
+            self.assertEqual(self.pop.mutations[i].neutral, True)
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -63,5 +63,221 @@ class testCythonRecorder(unittest.TestCase):
         evolve(self.rng, self.pop, self.p, self.cython_recorder)
 
 
+class testGameteCompaction(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        from fwdpy11 import ModelParams
+        from fwdpy11 import Multiplicative
+        self.p = ModelParams()
+        self.p.rates = (1e-3, 1e-3, 1e-3)
+        # A bottleneck leaves many extinct gametes behind
+        self.p.demography = np.array([1000] * 50 + [50] * 10 + [1000] * 10,
+                                     dtype=np.uint32)
+        self.p.nregions = [fp11.Region(0, 1, 1)]
+        self.p.sregions = [fp11.ExpS(0, 1, 1, -1e-2)]
+        self.p.recregions = self.p.nregions
+        self.p.gvalue = Multiplicative(2.0)
+
+    def testCompactionDoesNotChangeOutcome(self):
+        from fwdpy11 import evolve_genomes as evolve
+        pop = fp11.DiploidPopulation(1000)
+        evolve(fp11.GSLrng(42), pop, self.p)
+        cpop = fp11.DiploidPopulation(1000)
+        evolve(fp11.GSLrng(42), cpop, self.p,
+               gamete_compaction_threshold=1.0)
+        self.assertTrue(all([g.n > 0 for g in cpop.haploid_genomes]))
+        self.assertTrue(len(cpop.haploid_genomes) <=
+                        len(pop.haploid_genomes))
+        self.assertEqual(list(pop.mcounts), list(cpop.mcounts))
+        for i, j in zip(pop.diploids, cpop.diploids):
+            for a, b in zip([i.first, i.second], [j.first, j.second]):
+                self.assertEqual(list(pop.haploid_genomes[a].mutations),
+                                 list(cpop.haploid_genomes[b].mutations))
+                self.assertEqual(list(pop.haploid_genomes[a].smutations),
+                                 list(cpop.haploid_genomes[b].smutations))
+
+    def testInvalidThreshold(self):
+        from fwdpy11 import evolve_genomes as evolve
+        pop = fp11.DiploidPopulation(1000)
+        with self.assertRaises(ValueError):
+            evolve(fp11.GSLrng(42), pop, self.p,
+                   gamete_compaction_threshold=1.5)
+
+
+
+class testBackgroundSelection(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        from fwdpy11 import ModelParams
+        from fwdpy11 import Multiplicative
+        self.N = 1000
+        self.p = ModelParams()
+        self.p.rates = (0.0, 0.0, 1e-2)
+        self.p.demography = np.array([self.N] * 50, dtype=np.uint32)
+        self.p.nregions = []
+        self.p.sregions = []
+        self.p.recregions = [fp11.Region(0, 10, 1)]
+        self.p.gvalue = Multiplicative(2.0)
+
+    def testEvolve(self):
+        from fwdpy11 import evolve_genomes as evolve
+        blocks = [(i, i + 1, 0.05, 0.01) for i in range(10)]
+        bgs = fp11.BackgroundSelection(blocks)
+        pop = fp11.DiploidPopulation(self.N)
+        evolve(fp11.GSLrng(42), pop, self.p, background_selection=bgs)
+        loads = bgs.loads
+        self.assertEqual(loads.shape, (2 * self.N, 10))
+        self.assertTrue(loads.sum() > 0)
+        # Fixed mutations are removed
+        self.assertTrue(all(loads.min(axis=0) == 0))
+        # No mutation objects were created
+        self.assertEqual(len(pop.mutations), 0)
+        for i, md in enumerate(pop.diploid_metadata):
+            k = loads[2 * i, :].sum() + loads[2 * i + 1, :].sum()
+            self.assertAlmostEqual(md.w, 0.99**k)
+            self.assertAlmostEqual(md.w, bgs.fitness(i))
+
+    def testNoMutation(self):
+        from fwdpy11 import evolve_genomes as evolve
+        bgs = fp11.BackgroundSelection([(0, 10, 0.0, 0.01)])
+        pop = fp11.DiploidPopulation(self.N)
+        evolve(fp11.GSLrng(42), pop, self.p, background_selection=bgs)
+        self.assertEqual(bgs.loads.sum(), 0)
+        self.assertTrue(all([md.w == 1.0 for md in pop.diploid_metadata]))
+
+    def testStateTiedToPopulation(self):
+        """
+        The counts are kept when the same population is evolved
+        further, and discarded when another population is used.
+        """
+        from fwdpy11 import evolve_genomes as evolve
+        from fwdpy11 import ModelParams
+        blocks = [(i, i + 1, 0.05, 0.01) for i in range(10)]
+        bgs = fp11.BackgroundSelection(blocks)
+        pop = fp11.DiploidPopulation(self.N)
+        evolve(fp11.GSLrng(42), pop, self.p, background_selection=bgs)
+        p = ModelParams()
+        p.rates = self.p.rates
+        p.nregions = []
+        p.sregions = []
+        p.recregions = self.p.recregions
+        p.gvalue = self.p.gvalue
+        p.demography = np.array([self.N], dtype=np.uint32)
+        evolve(fp11.GSLrng(42), pop, p, background_selection=bgs)
+        continued = bgs.loads.sum()
+        other = fp11.DiploidPopulation(self.N)
+        evolve(fp11.GSLrng(42), other, p, background_selection=bgs)
+        self.assertTrue(bgs.loads.sum() < continued)
+        for i, md in enumerate(other.diploid_metadata):
+            self.assertAlmostEqual(md.w, bgs.fitness(i))
+
+    def testNewPopulationAtSameGeneration(self):
+        """
+        A new population evolved to the same generation,
+        which may reuse the memory of the previous one,
+        does not inherit its counts.
+        """
+        import pickle
+        from fwdpy11 import evolve_genomes as evolve
+        from fwdpy11 import ModelParams
+        blocks = [(i, i + 1, 0.05, 0.01) for i in range(10)]
+        bgs = fp11.BackgroundSelection(blocks)
+        pop = fp11.DiploidPopulation(self.N)
+        evolve(fp11.GSLrng(42), pop, self.p, background_selection=bgs)
+        del pop
+        pop = fp11.DiploidPopulation(self.N)
+        evolve(fp11.GSLrng(101), pop, self.p)
+        p = ModelParams()
+        p.rates = self.p.rates
+        p.nregions = []
+        p.sregions = []
+        p.recregions = self.p.recregions
+        p.gvalue = self.p.gvalue
+        p.demography = np.array([self.N], dtype=np.uint32)
+        copy = pickle.loads(pickle.dumps(pop))
+        evolve(fp11.GSLrng(42), pop, p, background_selection=bgs)
+        fresh = fp11.BackgroundSelection(blocks)
+        evolve(fp11.GSLrng(42), copy, p, background_selection=fresh)
+        self.assertTrue(np.array_equal(bgs.loads, fresh.loads))
+
+    def testInvalidBlocks(self):
+        with self.assertRaises(ValueError):
+            fp11.BackgroundSelection([])
+        with self.assertRaises(ValueError):
+            fp11.BackgroundSelection([(0, 2, 0.1, 0.01), (1, 3, 0.1, 0.01)])
+        with self.assertRaises(ValueError):
+            fp11.BackgroundSelection([(0, 1, -0.1, 0.01)])
+        with self.assertRaises(ValueError):
+            fp11.BackgroundSelection([(0, 1, 0.1, 1.0)])
+
+
+class testParallelFitness(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        from fwdpy11 import ModelParams
+        self.N = 3000
+        self.p = ModelParams()
+        self.p.rates = (0.0, 1e-3, 1e-3)
+        self.p.demography = np.array([self.N] * 20, dtype=np.uint32)
+        self.p.nregions = []
+        self.p.sregions = [fp11.GaussianS(0, 1, 1, 0.1)]
+        self.p.recregions = [fp11.Region(0, 1, 1)]
+        self.p.gvalue = fp11.Additive(2.0, fp11.GSS(0.0, 1.0),
+                                      fp11.GaussianNoise(mean=0.0, sd=0.5))
+
+    def testSameOutcomeForAnyThreadCount(self):
+        from fwdpy11 import evolve_genomes as evolve
+        pops = []
+        for nthreads in [1, 2, 4]:
+            pop = fp11.DiploidPopulation(self.N)
+            evolve(fp11.GSLrng(42), pop, self.p, nthreads=nthreads)
+            pops.append(pop)
+        for pop in pops[1:]:
+            for i, j in zip(pops[0].diploid_metadata, pop.diploid_metadata):
+                self.assertEqual(i.g, j.g)
+                self.assertEqual(i.e, j.e)
+                self.assertEqual(i.w, j.w)
+
+    def testParallelPathTaken(self):
+        from fwdpy11 import evolve_genomes as evolve
+        from fwdpy11._fwdpy11 import _parallel_evaluation_count
+        # Fitness is calculated once per generation, and at the start
+        nevaluations = len(self.p.demography) + 1
+        for nthreads in [1, 2, 4]:
+            before = _parallel_evaluation_count()
+            pop = fp11.DiploidPopulation(self.N)
+            evolve(fp11.GSLrng(42), pop, self.p, nthreads=nthreads)
+            self.assertEqual(_parallel_evaluation_count() - before,
+                             nevaluations)
+
+    def testSerialFallback(self):
+        """
+        Models with shared state are evaluated serially
+        """
+        from fwdpy11 import evolve_genomes as evolve
+        from fwdpy11 import ModelParams
+        from fwdpy11._fwdpy11 import _parallel_evaluation_count
+        gvalue = fp11.Additive(2.0, fp11.GSS(0.0, 1.0),
+                               fp11.GaussianNoise(mean=0.0, sd=0.5))
+        gvalue.cache_haploid_effects = True
+        p = ModelParams()
+        p.rates = self.p.rates
+        p.demography = self.p.demography
+        p.nregions = []
+        p.sregions = self.p.sregions
+        p.recregions = self.p.recregions
+        p.gvalue = gvalue
+        before = _parallel_evaluation_count()
+        pop = fp11.DiploidPopulation(self.N)
+        evolve(fp11.GSLrng(42), pop, p, nthreads=4)
+        self.assertEqual(_parallel_evaluation_count(), before)
+
+    def testInvalidThreadCount(self):
+        from fwdpy11 import evolve_genomes as evolve
+        pop = fp11.DiploidPopulation(self.N)
+        with self.assertRaises(ValueError):
+            evolve(fp11.GSLrng(42), pop, self.p, nthreads=0)
+
+
 if __name__ == "__main__":
     unittest.main()